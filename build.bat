@@ -12,6 +12,15 @@
 @REM NOTE: You will also need to add any extra parameters to Zeta's
 @REM        compilation 
 
+@REM NOTE: Run "build.bat deterministic" to build Zeta with ZETA_DETERMINISTIC.
+@REM        Code that shares the simulation with Zeta has to be compiled
+@REM        with the same flags (see include/ZETA/zmath2D.h).
+
+set ZETA_FLAGS=
+if "%1"=="deterministic" (
+    set ZETA_FLAGS=-DZETA_DETERMINISTIC -ffp-contract=off
+)
+
 echo "Build Starting"
 
 @REM This should only be uncommented if you move the script out of ZETA's scope.
@@ -63,7 +72,7 @@ if not exist "lib/" (
 @REM create the object and library files
 pushd "build/"
 
-    g++ -O3 -I../include -c ../src/*.cpp
+    g++ -O3 %ZETA_FLAGS% -I../include -c ../src/*.cpp
     g++ -shared -Wl,-soname,../libzeta2d.dll -Wl,--out-implib,../lib/libzeta2d.a -o ../lib/zeta2d.dll *.o
 
 popd @REM "build/"
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "memory.h"
+#include <cstddef>
+
+namespace Zeta {
+    // * ========================
+    // * Frame Arena
+    // * ========================
+
+    // ? A frame arena hands out memory for data that only lives for a single step (collision wrappers and contact points).
+    // ? Allocating is a pointer bump and everything is freed at once by reset, so a step never frees anything on its own.
+    // ? Allocations that do not fit go into overflow blocks. The next reset frees them and grows the buffer to the peak usage,
+    // ?  so once the arena has seen its worst step it never allocates again. Reserve the peak up front to skip the warm up.
+
+    // Overflow allocation that did not fit in the arena's buffer.
+    struct ArenaBlock {
+        ArenaBlock* next;
+        size_t size; // bytes allocated for the block
+        alignas(alignof(std::max_align_t)) char data[1];
+    };
+
+    class FrameArena {
+        private:
+            char* data = nullptr;
+            size_t capacity = 0; // size of data in bytes
+            size_t used = 0; // bytes of data handed out since the last reset
+            size_t frameBytes = 0; // bytes handed out since the last reset including the overflow blocks
+            size_t peak = 0; // most bytes handed out between two resets
+            size_t reserved = 0; // min size of the buffer requested through reserve
+            ArenaBlock* overflow = nullptr; // blocks allocated since the last reset
+            std::pmr::memory_resource* resource; // where the buffer and blocks come from. nullptr = new and delete.
+
+            // Free the overflow blocks.
+            void freeOverflow();
+
+        public:
+            inline FrameArena(std::pmr::memory_resource* resource = nullptr) : resource(resource) {};
+
+            // The arena owns its memory.
+            FrameArena(FrameArena const &arena) = delete;
+            FrameArena& operator = (FrameArena const &arena) = delete;
+
+            ~FrameArena();
+
+            // Get size bytes aligned to align (a power of 2 no larger than alignof(std::max_align_t)).
+            // The memory stays valid until the next reset.
+            void* allocate(size_t size, size_t align);
+
+            // Get an uninitialized array of n Ts. T must be trivially destructible since it is never destroyed.
+            template <typename T>
+            inline T* alloc(int n) { return (T*) allocate(n*sizeof(T), alignof(T)); };
+
+            // Free everything handed out since the last reset.
+            // Only allocates if the arena overflowed since the last reset, in which case the buffer grows to the peak usage.
+            void reset();
+
+            // Make sure at least bytes fit between two resets without overflowing.
+            // The buffer grows right away if nothing has been handed out since the last reset, otherwise at the next reset.
+            void reserve(size_t bytes);
+
+            // Get the most bytes used between two resets so far.
+            inline size_t getPeak() const { return peak; };
+
+            // Get the size of the buffer in bytes.
+            inline size_t getCapacity() const { return capacity; };
+    };
+}
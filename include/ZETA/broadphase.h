@@ -0,0 +1,216 @@
+#pragma once
+
+#include "intersections.h"
+#include "memory.h"
+
+namespace Zeta {
+    // * ======================
+    // * Bounding Boxes
+    // * ======================
+
+    // Compute the world space bounding box of a circle.
+    extern void computeBounds(Circle const &circle, ZMath::Vec2D &min, ZMath::Vec2D &max);
+
+    // Compute the world space bounding box of an AABB.
+    extern void computeBounds(AABB const &aabb, ZMath::Vec2D &min, ZMath::Vec2D &max);
+
+    // Compute the world space bounding box of a Box2D.
+    extern void computeBounds(Box2D const &box, ZMath::Vec2D &min, ZMath::Vec2D &max);
+
+    // Get the world space bounding box of a body's collider from the bounds cached in the body.
+    // Returns 0 if the body does not have a collider.
+    extern bool computeBounds(BodyRef const &ref, ZMath::Vec2D &min, ZMath::Vec2D &max);
+
+
+    // * ======================================
+    // * Bounding Volume Hierarchy (BVH)
+    // * ======================================
+
+    // Max number of bodies stored in a single leaf of a BVH.
+    static const int BVH_LEAF_SIZE = 4;
+
+    // Max depth of the traversal stack used when querying a BVH.
+    static const int BVH_STACK_SIZE = 64;
+
+    // A refitted BVH is rebuilt once the total perimeter of its nodes grows past this many times what it was when it was built.
+    static const float BVH_REFIT_LIMIT = 2.0f;
+
+    struct BVHNode {
+        ZMath::Vec2D min, max; // bounds of everything under this node
+        int left; // index of the left child (the right child is left + 1) or the index of the first item if this is a leaf
+        int count; // number of items in this leaf. 0 for internal nodes.
+    };
+
+    struct BVHItem {
+        ZMath::Vec2D min, max; // bounds of the body's collider
+        BodyRef ref;
+        int index; // order the item was added in. Breaks ties when splitting under ZETA_DETERMINISTIC.
+    };
+
+    // Bounding volume hierarchy over the colliders of a set of bodies.
+    // Nodes and items are stored in flat arrays and the hierarchy is built from scratch with a median split.
+    // When the bodies only move, refit updates the boxes in place without rebuilding the hierarchy.
+    class BVH {
+        public:
+            BVHNode* nodes = nullptr;
+            BVHItem* items = nullptr;
+
+            int nodeCount = 0;
+            int itemCount = 0;
+            int capacity = 0; // max number of items that fit without reallocating
+            float buildCost = 0.0f; // total perimeter of the nodes right after the last build
+
+            std::pmr::memory_resource* resource = nullptr; // where the arrays come from. nullptr = new and delete. Set before the first reserve.
+
+            inline BVH() {};
+
+            // The BVH owns its arrays.
+            BVH(BVH const &bvh) = delete;
+            BVH& operator = (BVH const &bvh) = delete;
+
+            ~BVH();
+
+            // Ensure n items fit without any allocation during add or build.
+            void reserve(int n);
+
+            // Remove every item.
+            inline void clear() {
+                itemCount = 0;
+                nodeCount = 0;
+            };
+
+            // Add a body to the BVH. Bodies without a collider are skipped.
+            // Call build after adding the bodies. reserve must have been called with enough capacity.
+            void add(BodyRef const &ref);
+
+            // Build the hierarchy over every item that has been added.
+            void build();
+
+            // Update the bounds of every item from the bounds cached in its body, then the bounds of every node from its children.
+            // The hierarchy is kept, so this is linear in the number of items but the boxes overlap more as the bodies drift apart.
+            // Returns the total perimeter of the nodes afterwards, which can be compared against buildCost to judge the tree.
+            float refit();
+    };
+
+
+    // * ======================
+    // * Raycasting
+    // * ======================
+
+    struct RaycastHit {
+        BodyRef body; // the body that was hit
+        ZMath::Vec2D point; // where the ray hit the body
+        ZMath::Vec2D normal; // surface normal of the body at point
+        float dist; // distance along the ray to point
+    };
+
+    // Determine if a ray intersects a body's collider.
+    // dist and normal behave like they do for the primitive raycasts.
+    extern bool raycast(BodyRef const &ref, Ray2D const &ray, float &dist, ZMath::Vec2D &normal);
+
+    /**
+     * @brief Cast a ray against the bodies in a BVH. Sensors are ignored.
+     * 
+     * @param tree The BVH to traverse.
+     * @param ray The ray to cast.
+     * @param maxDist Only hits closer than this are considered.
+     * @param hit Set to the closest hit if there is one closer than maxDist.
+     * @param any If true, stop at the first hit found instead of the closest.
+     * @return (bool) 1 if hit was updated. 0 otherwise.
+     */
+    extern bool raycast(BVH const &tree, Ray2D const &ray, float maxDist, RaycastHit &hit, bool any = 0);
+
+    /**
+     * @brief Find every body in a BVH intersected by a ray. Sensors are ignored.
+     * 
+     * @param tree The BVH to traverse.
+     * @param ray The ray to cast.
+     * @param maxDist Only hits closer than this are considered.
+     * @param hits Sorted array of hits (closest first). New hits are merged in. If it fills up, only the closest hits are kept.
+     * @param count Number of hits already stored in hits.
+     * @param capacity Max number of hits that can be stored in hits.
+     * @return (int) The number of hits now stored in hits.
+     */
+    extern int raycastAll(BVH const &tree, Ray2D const &ray, float maxDist, RaycastHit* hits, int count, int capacity);
+
+    // Number of rays traced together by raycastPacket.
+    static const int RAY_PACKET_SIZE = 4;
+
+    /**
+     * @brief Cast a packet of rays against the bodies in a BVH. Sensors are ignored.
+     *        Each node is tested against every ray in the packet at once (using SSE when available) and is culled
+     *        as soon as none of the rays can find a closer hit inside of it. This works best for coherent rays such as fans from one origin.
+     * 
+     * @param tree The BVH to traverse.
+     * @param rays The rays in the packet.
+     * @param count Number of rays in the packet. Must be at most RAY_PACKET_SIZE.
+     * @param best The distance to the best hit found so far for each ray. Only closer hits are considered and it is updated as they are found.
+     * @param hits The best hit for each ray. Updated alongside best.
+     */
+    extern void raycastPacket(BVH const &tree, Ray2D const* rays, int count, float* best, RaycastHit* hits);
+
+
+    // * ======================
+    // * Region Queries
+    // * ======================
+
+    /**
+     * @brief Find every body in a BVH whose collider overlaps a region. Sensors are included.
+     * 
+     * @param tree The BVH to traverse.
+     * @param type The region's RigidBodyCollider value (RIGID_CIRCLE_COLLIDER, RIGID_AABB_COLLIDER or RIGID_BOX2D_COLLIDER).
+     * @param region The primitive describing the region.
+     * @param bodies Array the overlapping bodies are appended to.
+     * @param count Number of bodies already stored in bodies.
+     * @param capacity Max number of bodies that can be stored in bodies. Bodies past this are dropped.
+     * @return (int) The number of bodies now stored in bodies.
+     */
+    extern int query(BVH const &tree, int type, void const* region, BodyRef* bodies, int count, int capacity);
+
+
+    // * ======================
+    // * Shape Casting
+    // * ======================
+
+    struct ShapecastHit {
+        BodyRef body; // the body that was hit
+        ZMath::Vec2D normal; // surface normal of the body at the point of impact. Points towards the swept shape.
+        float dist; // how far the shape can move along the direction before touching the body
+    };
+
+    /**
+     * @brief Sweep a primitive along a direction and find when it first touches a body's collider.
+     *        This steps the shape forward by less than the thickness of either shape and then bisects to the time of impact,
+     *        so thin bodies cannot be tunneled through. Unless exact is set, the number of steps is capped, so a degenerate shape
+     *        (such as a flat box) costs no more than any other, but a long sweep can step over a body that is thinner than its steps.
+     *        If the shape already overlaps the body, dist is 0 unless the shape is moving out of the body, in which case it does not hit it.
+     * 
+     * @param ref The body to sweep against.
+     * @param type The swept primitive's RigidBodyCollider value (RIGID_CIRCLE_COLLIDER, RIGID_AABB_COLLIDER or RIGID_BOX2D_COLLIDER).
+     * @param shape The swept primitive at its starting position.
+     * @param dir The normalized direction to sweep in.
+     * @param maxDist How far to sweep.
+     * @param dist Set to the distance the shape can travel before touching the body.
+     * @param normal Set to the surface normal of the body at the point of impact.
+     * @param exact 1 = never cap the number of steps. Use this when missing a hit is worse than a slow sweep, such as for bullets.
+     * @return (bool) 1 if the shape touches the body within maxDist. 0 otherwise.
+     */
+    extern bool shapecast(BodyRef const &ref, int type, void const* shape, ZMath::Vec2D const &dir, float maxDist, float &dist, ZMath::Vec2D &normal,
+                          bool exact = 0);
+
+    /**
+     * @brief Sweep a primitive against the bodies in a BVH and find the first one it touches. Sensors are ignored.
+     * 
+     * @param tree The BVH to traverse.
+     * @param type The swept primitive's RigidBodyCollider value.
+     * @param shape The swept primitive at its starting position.
+     * @param dir The normalized direction to sweep in.
+     * @param maxDist Only hits closer than this are considered.
+     * @param hit Set to the first hit if there is one closer than maxDist.
+     * @param ignore A body to skip, such as the body the swept shape belongs to. nullptr to skip nothing.
+     * @param exact 1 = never cap the number of steps taken against each body.
+     * @return (bool) 1 if hit was updated. 0 otherwise.
+     */
+    extern bool shapecast(BVH const &tree, int type, void const* shape, ZMath::Vec2D const &dir, float maxDist, ShapecastHit &hit,
+                          void const* ignore = nullptr, bool exact = 0);
+}
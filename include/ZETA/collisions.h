@@ -1,6 +1,7 @@
 #pragma once
 
 #include "intersections.h"
+#include "arena.h"
 
 namespace Zeta {
     // * =========================
@@ -8,6 +9,10 @@ namespace Zeta {
     // * =========================
 
     // ? Note: if we have objects A and B colliding, the collison normal will point towards B and away from A.
+    // ? Speculative contacts (see Handler::speculativeContacts) are manifolds between bodies that are not touching yet.
+    // ?  They have no contact points and their pDist is the negative of the gap between the bodies.
+    // ? The contact points are allocated from the arena passed to findCollisionFeatures and freed when it is reset.
+    // ?  Without an arena they are allocated with new[] and have to be freed with delete[].
 
     struct CollisionManifold {
         ZMath::Vec2D normal; // collision normal
@@ -34,9 +39,9 @@ namespace Zeta {
     // * Collision Manifold Calculators
     // * ===================================
 
-    extern CollisionManifold findCollisionFeatures(Circle const &circle1, Circle const &circle2);
-    extern CollisionManifold findCollisionFeatures(Circle const &circle, AABB const &aabb);
-    extern CollisionManifold findCollisionFeatures(Circle const &circle, Box2D const &box);
+    extern CollisionManifold findCollisionFeatures(Circle const &circle1, Circle const &circle2, FrameArena* arena = nullptr);
+    extern CollisionManifold findCollisionFeatures(Circle const &circle, AABB const &aabb, FrameArena* arena = nullptr);
+    extern CollisionManifold findCollisionFeatures(Circle const &circle, Box2D const &box, FrameArena* arena = nullptr);
 
 
     // * ====================================================
@@ -78,33 +83,33 @@ namespace Zeta {
 
     // ? Normal points towards B and away from A
 
-    extern CollisionManifold findCollisionFeatures(AABB const &aabb1, AABB const &aabb2);
+    extern CollisionManifold findCollisionFeatures(AABB const &aabb1, AABB const &aabb2, FrameArena* arena = nullptr);
 
     // ? Normal points towards B and away from A
 
-    extern CollisionManifold findCollisionFeatures(AABB const &aabb, Box2D const &box);
+    extern CollisionManifold findCollisionFeatures(AABB const &aabb, Box2D const &box, FrameArena* arena = nullptr);
 
     // ? Normal points towards B and away from A
 
-    extern CollisionManifold findCollisionFeatures(Box2D const &box1, Box2D const &box2);
+    extern CollisionManifold findCollisionFeatures(Box2D const &box1, Box2D const &box2, FrameArena* arena = nullptr);
 
     // Find the collision features and resolve the impulse between two arbitrary primitives.
     // The normal will point towards B and away from A.
-    extern CollisionManifold findCollisionFeatures(RigidBody2D* rb1, RigidBody2D* rb2);
+    extern CollisionManifold findCollisionFeatures(RigidBody2D* rb1, RigidBody2D* rb2, FrameArena* arena = nullptr);
 
     // Find the collision features between a rigid and static body.
     // The normal will point away from the static body and towards the rigid body.
-    extern CollisionManifold findCollisionFeatures(RigidBody2D* rb, StaticBody2D* sb);
+    extern CollisionManifold findCollisionFeatures(RigidBody2D* rb, StaticBody2D* sb, FrameArena* arena = nullptr);
 
     // Find the collision features between a rigid and kinematic body.
     // The normal will point away from the kinematic body and towards the rigid body.
-    extern CollisionManifold findCollisionFeatures(RigidBody2D* rb, KinematicBody2D* kb);
+    extern CollisionManifold findCollisionFeatures(RigidBody2D* rb, KinematicBody2D* kb, FrameArena* arena = nullptr);
 
     // Find the collision features between a kinematic and static body.
     // The normal will point away from the static body and towards the kinematic body.
-    extern CollisionManifold findCollisionFeatures(KinematicBody2D* kb, StaticBody2D* sb);
+    extern CollisionManifold findCollisionFeatures(KinematicBody2D* kb, StaticBody2D* sb, FrameArena* arena = nullptr);
 
     // Find the collision features between two kinematic bodies.
     // The normal points towards B and away from A.
-    extern CollisionManifold findCollisionFeatures(KinematicBody2D* kb1, KinematicBody2D* kb2);
+    extern CollisionManifold findCollisionFeatures(KinematicBody2D* kb1, KinematicBody2D* kb2, FrameArena* arena = nullptr);
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "bodies.h"
+#include "memory.h"
+#include <atomic>
+
+namespace Zeta {
+    // * =====================
+    // * Contact Events
+    // * =====================
+
+    // Type of contact event generated by the handler.
+    enum ContactEventType {
+        CONTACT_BEGIN, // the bodies started touching this step
+        CONTACT_PERSIST, // the bodies were already touching during the previous step
+        CONTACT_END // the bodies stopped touching this step
+    };
+
+    // A change in the contact state between two bodies.
+    // ? The normal points towards body2 and away from body1 (the same convention used by the collision manifolds).
+    struct ContactEvent {
+        BodyRef body1;
+        BodyRef body2;
+        ZMath::Vec2D normal; // collision normal. Zero for CONTACT_END.
+        float pDist; // penetration distance. Zero for CONTACT_END.
+        ContactEventType type;
+    };
+
+
+    // * ====================================
+    // * Contact Event Queue (SPSC)
+    // * ====================================
+
+    // Lock-free single-producer/single-consumer ring buffer used to deliver contact events.
+    // The physics thread is the only producer and a single game thread may drain it concurrently.
+    // The buffer is allocated once on construction and never grows. Events pushed while it is full are dropped and counted.
+    class ContactEventQueue {
+        private:
+            ContactEvent* events; // ring buffer storage
+            std::pmr::memory_resource* resource; // where events comes from. nullptr = new and delete.
+            unsigned int mask; // capacity - 1 (capacity is always a power of 2)
+
+            // ? head and tail live on separate cache lines so the producer and consumer do not fight over them.
+
+            alignas(64) std::atomic<unsigned int> head; // next event to be read. Written by the consumer.
+            alignas(64) std::atomic<unsigned int> tail; // one past the last published event. Written by the producer.
+            unsigned int pendingTail; // one past the last event written but not yet published. Producer only.
+            unsigned int cachedHead; // producer's last known value of head.
+            std::atomic<unsigned int> dropped; // number of events dropped because the queue was full.
+
+        public:
+            /**
+             * @brief Create a contact event queue.
+             * 
+             * @param capacity The max number of unread events. This is rounded up to the next power of 2.
+             * @param resource Where the buffer is allocated from. nullptr = new and delete.
+             */
+            ContactEventQueue(int capacity, std::pmr::memory_resource* resource = nullptr);
+
+            // The queue owns its buffer and the atomics cannot be copied.
+            ContactEventQueue(ContactEventQueue const &queue) = delete;
+            ContactEventQueue& operator = (ContactEventQueue const &queue) = delete;
+
+            ~ContactEventQueue();
+
+            // * Producer functions. Only call these from the thread stepping the physics.
+
+            // Write an event to the queue without making it visible to the consumer.
+            // 1 = the event was written. 0 = the queue is full and the event was dropped.
+            bool push(ContactEvent const &event);
+
+            // Make every event pushed since the last publish visible to the consumer at once.
+            void publish();
+
+            // * Consumer functions. Only call these from a single reading thread.
+
+            // Read the oldest event.
+            // 1 = an event was read. 0 = the queue is empty.
+            bool pop(ContactEvent &event);
+
+            // Read up to max events into out.
+            // Returns the number of events read.
+            int pop(ContactEvent* out, int max);
+
+            // * Either thread.
+
+            // The max number of unread events the queue can hold.
+            inline int getCapacity() const { return mask + 1; };
+
+            // Get the number of events dropped since the queue was created.
+            inline unsigned int getDropped() const { return dropped.load(std::memory_order_relaxed); };
+    };
+}
@@ -58,6 +58,24 @@ namespace Zeta {
     // dist is set to -1 if there is no intersection.
     extern bool raycast(Box2D const &box, Ray2D const &ray, float &dist);
 
+    // ? The following also report the surface normal at the hit point.
+    // ? If the ray starts inside of the primitive, the hit point is where the ray exits it (consistent with the functions above).
+
+    // Determine if a ray intersects a circle.
+    // dist will be set to the distance along the ray to the hit point and normal to the circle's surface normal at that point.
+    // dist is set to -1 if there is no intersection.
+    extern bool raycast(Circle const &circle, Ray2D const &ray, float &dist, ZMath::Vec2D &normal);
+
+    // Determine if a ray intersects an AABB.
+    // dist will be set to the distance along the ray to the hit point and normal to the AABB's surface normal at that point.
+    // dist is set to -1 if there is no intersection.
+    extern bool raycast(AABB const &aabb, Ray2D const &ray, float &dist, ZMath::Vec2D &normal);
+
+    // Determine if a ray intersects a Box2D.
+    // dist will be set to the distance along the ray to the hit point and normal to the Box2D's surface normal at that point.
+    // dist is set to -1 if there is no intersection.
+    extern bool raycast(Box2D const &box, Ray2D const &ray, float &dist, ZMath::Vec2D &normal);
+
     // * ===================================
     // * Circle vs Primitives
     // * ===================================
@@ -167,4 +185,35 @@ namespace Zeta {
     // If there is not an intersection, the normal will be a junk value.
     // The normal will point towards B away from A.
     extern bool Box2DAndBox2D(Box2D const &box1, Box2D const &box2, ZMath::Vec2D &normal);
+
+    // * ===================================
+    // * Body vs Body
+    // * ===================================
+
+    // ? These only determine if the colliders overlap. They are much cheaper than computing a collision manifold
+    // ?  and are what the handler uses for pairs involving a sensor.
+
+    // Determine if the colliders of two rigid bodies intersect.
+    extern bool RigidAndRigid(RigidBody2D* rb1, RigidBody2D* rb2);
+
+    // Determine if the colliders of a rigid and static body intersect.
+    extern bool RigidAndStatic(RigidBody2D* rb, StaticBody2D* sb);
+
+    // Determine if the colliders of a rigid and kinematic body intersect.
+    extern bool RigidAndKinematic(RigidBody2D* rb, KinematicBody2D* kb);
+
+    // Determine if the colliders of a kinematic and static body intersect.
+    extern bool KinematicAndStatic(KinematicBody2D* kb, StaticBody2D* sb);
+
+    // Determine if the colliders of two kinematic bodies intersect.
+    extern bool KinematicAndKinematic(KinematicBody2D* kb1, KinematicBody2D* kb2);
+
+    // Determine if a body's collider intersects a primitive.
+    // type is the primitive's RigidBodyCollider value (RIGID_CIRCLE_COLLIDER, RIGID_AABB_COLLIDER or RIGID_BOX2D_COLLIDER).
+    extern bool BodyAndCollider(BodyRef const &ref, int type, void const* collider);
+
+    // Check for intersection between a body's collider and a primitive and return the collision normal.
+    // If there is not an intersection, the normal will be a junk value.
+    // The normal will point towards the primitive and away from the body.
+    extern bool BodyAndCollider(BodyRef const &ref, int type, void const* collider, ZMath::Vec2D &normal);
 }
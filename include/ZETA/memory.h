@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory_resource>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Zeta {
+    // * ========================
+    // * Memory Resources
+    // * ========================
+
+    // ? Everything the handler allocates goes through these so any std::pmr::memory_resource can back it (see Handler).
+    // ? A nullptr resource means plain new and delete, so bodies made with new can still be handed to a handler without one.
+    // ? Memory from a resource has to be returned with the same size it was allocated with, so pass the capacity when freeing.
+
+    // Allocate an array of n default initialized Ts.
+    template <typename T>
+    inline T* allocArray(std::pmr::memory_resource* resource, size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "arrays from a memory resource are never destroyed");
+
+        if (!resource) { return new T[n]; }
+
+        T* arr = (T*) resource->allocate(n*sizeof(T), alignof(T));
+        std::uninitialized_default_construct_n(arr, n);
+
+        return arr;
+    };
+
+    // Free an array of n Ts allocated by allocArray with the same resource.
+    template <typename T>
+    inline void freeArray(std::pmr::memory_resource* resource, T* arr, size_t n) {
+        if (!resource) { delete[] arr; }
+        else if (arr) { resource->deallocate(arr, n*sizeof(T), alignof(T)); }
+    };
+
+    // Construct a T from the resource.
+    template <typename T, typename... Args>
+    inline T* newObject(std::pmr::memory_resource* resource, Args&&... args) {
+        if (!resource) { return new T(std::forward<Args>(args)...); }
+        return ::new (resource->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    };
+
+    // Destroy and free a T constructed by newObject with the same resource.
+    template <typename T>
+    inline void deleteObject(std::pmr::memory_resource* resource, T* obj) {
+        if (!resource) { delete obj; }
+        else if (obj) {
+            obj->~T();
+            resource->deallocate(obj, sizeof(T), alignof(T));
+        }
+    };
+}
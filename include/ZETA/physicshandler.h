@@ -1,7 +1,12 @@
 #pragma once
 
 #include "collisions.h"
+#include "broadphase.h"
+#include "events.h"
+#include "scene.h"
+#include "recorder.h"
 #include <stdexcept>
+#include <cfloat>
 
 // todo maybe refactor so that everything is in a Zeta namespace (except for the ZMath stuff)
 // todo or at least make the collisions stuff in there, too
@@ -42,6 +47,18 @@ namespace Zeta {
 
     // todo -----------------------------------------------------------------------------------------------------------------------------
 
+    // ? Speculative impulses only remove as much approaching velocity as would close the gap by the end of the step.
+    // ?  There is no restitution since the bodies have not touched yet.
+
+    // Resolve a speculative contact between two rigidbodies.
+    extern void applySpeculativeImpulse(RigidBody2D* rb1, RigidBody2D* rb2, CollisionManifold const &manifold, float dt);
+
+    // Resolve a speculative contact between a rigid and static body.
+    extern void applySpeculativeImpulse(RigidBody2D* rb, StaticBody2D* sb, CollisionManifold const &manifold, float dt);
+
+    // Resolve a speculative contact between a rigid and kinematic body.
+    extern void applySpeculativeImpulse(RigidBody2D* rb, KinematicBody2D* kb, CollisionManifold const &manifold, float dt);
+
 
     // * ==============
     // * Wrappers
@@ -53,6 +70,7 @@ namespace Zeta {
     static const int halfStartingSlots = 32;
     static const int kStartingSlots = 4;
     static const int kHalfStartingSlots = 2;
+    static const size_t startingArenaBytes = 16384; // fits the starting collision wrappers and their contact points
 
     // ? For now, default to allocating 64 slots for Objects. Adjust once we start implementing more stuff.
 
@@ -76,6 +94,21 @@ namespace Zeta {
         int count; // number of kinematic bodies
     };
 
+    // Preallocated slots for rigid bodies that are spawned and despawned often, such as projectiles and debris.
+    struct RigidBodyPool {
+        RigidBody2D* bodies = nullptr; // every slot of the pool
+        int* indices = nullptr; // index of the body in each slot in the handler's rigid bodies. -1 = the slot is free.
+        int* freeSlots = nullptr; // stack of the free slots
+        int capacity = 0;
+        int freeCount = 0;
+    };
+
+    struct RigidBodyPools {
+        RigidBodyPool* pools = nullptr;
+        int capacity = 0;
+        int count = 0;
+    };
+
 
     // * CollisionWrapper Structs.
 
@@ -128,6 +161,157 @@ namespace Zeta {
     };
 
 
+    // * Sensor Structs.
+
+    // Type of overlap event reported for a sensor.
+    enum SensorEventType {
+        SENSOR_ENTER, // the bodies started overlapping this step
+        SENSOR_STAY, // the bodies were already overlapping during the previous step
+        SENSOR_EXIT // the bodies stopped overlapping this step, or one of them was removed since the previous update
+    };
+
+    // An overlap event between a sensor and another body.
+    struct SensorEvent {
+        BodyRef sensor; // if both bodies are sensors, this is the one that comes first in the handler's update order
+        BodyRef other;
+        SensorEventType type;
+    };
+
+    // Store pairs of bodies. Used to track which bodies overlap from one step to the next.
+    struct BodyPairs {
+        BodyRef* first = nullptr;
+        BodyRef* second = nullptr;
+
+        int capacity;
+        int count;
+    };
+
+    // Open addressing hash table used to match the body pairs from the previous step against the current step.
+    struct PairTable {
+        int* slots = nullptr; // indices into the pairs being matched. -1 denotes an empty slot.
+        bool* matched = nullptr; // whether each pair being matched was found during the current step
+
+        int slotCapacity; // always a power of 2
+        int capacity; // capacity of matched
+    };
+
+    // Store the sensor events generated during a call to update.
+    struct SensorEvents {
+        SensorEvent* events = nullptr;
+
+        int capacity;
+        int count;
+    };
+
+    // * Observer Structs.
+
+    // Type of visibility event reported for an observer.
+    enum VisibilityEventType {
+        VISIBILITY_ENTER, // the body entered the observer's view this step
+        VISIBILITY_LEAVE // the body left the observer's view this step
+    };
+
+    // A change in which bodies an observer can see.
+    struct VisibilityEvent {
+        int observer;
+        BodyRef body;
+        VisibilityEventType type;
+    };
+
+    // Store the visibility events generated during a call to update.
+    struct VisibilityEvents {
+        VisibilityEvent* events = nullptr;
+
+        int capacity = 0;
+        int count = 0;
+    };
+
+    // Views of the observers registered with the handler.
+    struct Observers {
+        ZMath::Vec2D* mins = nullptr;
+        ZMath::Vec2D* maxes = nullptr;
+        int* start = nullptr; // index of the observer's first pair in the visible pairs
+        int* visible = nullptr; // number of pairs the observer has in the visible pairs
+        bool* active = nullptr; // the observer has not been removed
+        bool* moved = nullptr; // the view was added or moved since the observers were last updated
+
+        int capacity = 0;
+        int count = 0;
+    };
+
+    // Bounds of the rigid bodies followed by the kinematic bodies when the observers were last updated.
+    // Views that did not move only test the bodies whose bounds changed since then.
+    struct ObservedBounds {
+        ZMath::Vec2D* mins = nullptr;
+        ZMath::Vec2D* maxes = nullptr;
+        int* changed = nullptr; // indices of the bodies whose bounds changed, found once per step for every still view
+        int changedCount = 0;
+        unsigned int generation = 0; // Handler::bodyIndexGeneration when the bounds were stored
+        bool stored = 0; // 0 = every view has to be queried again
+
+        int capacity = 0;
+    };
+
+    // Number of level of detail tiers rigid bodies can be placed in.
+    static const int LOD_TIERS = 4;
+
+    // Regions of the world where every rigid body is stepped at the full rate regardless of its level of detail tier.
+    struct ActiveRegions {
+        ZMath::Vec2D* mins = nullptr;
+        ZMath::Vec2D* maxes = nullptr;
+
+        int capacity = 0;
+        int count = 0;
+    };
+
+    // How many steps apart each rigid body is stepped during the current call to update.
+    struct LODIntervals {
+        int* intervals = nullptr;
+        bool* stepped = nullptr; // which rigid bodies are stepped on the current step
+        RigidBody2D** skipped = nullptr; // rigid bodies that are not stepped on the current step. Sorted once contact events need it.
+        int skippedCount = 0;
+        int capacity = 0;
+        bool enabled = 0; // at least one rigid body is not stepped every step
+    };
+
+    // A rigid body and its position along a Morton curve.
+    struct MortonEntry {
+        uint32_t key;
+        int index; // index before sorting. Breaks ties.
+        RigidBody2D* rb;
+    };
+
+    // Scratch space for sorting the rigid bodies along a Morton curve.
+    struct MortonOrder {
+        MortonEntry* entries = nullptr;
+        int capacity = 0;
+    };
+
+    // What the handler does once a call to update runs past its maxSteps or stepBudget.
+    enum StepLimitMode {
+        DROP_TIME, // skip the remaining whole steps
+        REDUCE_ITERATIONS // keep stepping with a single impulse iteration. Whole steps past maxSteps are still skipped.
+    };
+
+    // What a step does when it needs more memory than the handler has (see Handler::reserve).
+    enum MemoryLimitMode {
+        GROW_MEMORY, // allocate more
+        DROP_OVERFLOW, // drop the contacts, sensor overlaps, events, and visible bodies that do not fit
+        THROW_ON_OVERFLOW // throw a std::runtime_error. The handler is left in the middle of the step.
+    };
+
+    // Store the positions of the rigid and kinematic bodies at the start and end of the last step for render interpolation.
+    // Rigid bodies come first followed by the kinematic bodies, each in the order they are stored in the handler.
+    struct InterpolationBuffer {
+        ZMath::Vec2D* prev = nullptr; // positions at the start of the last step
+        ZMath::Vec2D* curr = nullptr; // positions at the end of the last step
+        unsigned int generation = 0; // Handler::bodyIndexGeneration when prev was stored
+
+        int capacity = 0;
+        int count = 0;
+    };
+
+
     // * ========================
     // * Main Physics Handler
     // * ========================
@@ -141,13 +325,51 @@ namespace Zeta {
             RigidBodies rbs; // rigid bodies to update
             StaticBodies sbs; // static bodies to update
             KinematicBodies kbs; // kinematic bodies to update
+            RigidBodyPools rigidPools; // allocated when the first pool is created
             CollisionWrapper colWrapper; // collision information
             StaticCollisionWrapper staticColWrapper; // collision information involving static body collisions
             RkCollisionWrapper rkColWrapper; // collision information involving rigid and kinematic body collisions
             SkCollisionWrapper skColWrapper; // collision information involving static and kinematic body collisions
             KinematicCollisionWrapper kColWrapper; // collision information involving kinematic body collisions
+            FrameArena frameArena; // memory for the collision wrappers and contact points of the current step
+            std::pmr::memory_resource* resource; // where the bodies and every internal array come from. nullptr = new and delete.
+            BodyPairs sensorPairs; // sensor overlaps found during the previous step
+            BodyPairs newSensorPairs; // sensor overlaps found during the current step
+            PairTable sensorTable; // used to diff sensorPairs and newSensorPairs
+            BodyPairs removedSensorPairs; // sensor overlaps ended by removing one of their bodies since the last update
+            SensorEvents sensorEvents; // sensor events generated during the last call to update
+            BodyPairs contactPairs; // contacts found during the previous step
+            BodyPairs newContactPairs; // contacts found during the current step
+            PairTable contactTable; // used to diff contactPairs and newContactPairs
+            ContactEventQueue* contactEvents = nullptr; // nullptr until contact events are enabled
+            Observers observers; // allocated when the first observer is added
+            BodyPairs visiblePairs; // bodies (first) visible to each observer (second) during the previous step
+            BodyPairs newVisiblePairs; // bodies visible to each observer during the current step
+            PairTable visibleTable; // used to diff visiblePairs and newVisiblePairs
+            ObservedBounds observedBounds; // bounds of the bodies when the observers were last updated
+            VisibilityEvents visibilityEvents; // visibility events generated during the last call to update
+            BVH staticTree; // broadphase structure for the static bodies
+            BVH dynamicTree; // broadphase structure for the rigid and kinematic bodies
+            bool staticTreeDirty = 1; // the static bodies changed since staticTree was built
+            bool dynamicTreeDirty = 1; // rigid or kinematic bodies were added or removed since dynamicTree was built
+            bool dynamicTreeMoved = 0; // the rigid or kinematic bodies moved since dynamicTree was last built or refitted
+            InterpolationBuffer interpolation; // body positions used to render between steps
+            unsigned int bodyIndexGeneration = 0; // bumped whenever a body is added, removed, or changes index
+            unsigned int bodySetGeneration = 0; // bumped whenever a body is added or removed, but not when bodies change index
+            float alpha = 0.0f; // how far between the last two steps the leftover dt reaches
+            float skippedTime = 0.0f; // simulation time skipped during the last call to update
+            int observerBodyTests = 0; // bodies tested against views that did not move during the last observer update
+            ActiveRegions activeRegions; // regions where rigid bodies are always stepped at the full rate
+            LODIntervals lod; // step interval of each rigid body for the current call to update
+            MortonOrder morton; // used to reorder the rigid bodies
+            unsigned int stepCounter = 0; // number of steps taken so far. Used to stagger lower rate bodies.
+            SceneFile* scene = nullptr; // scene loaded into the handler. Its static bodies live in the mapping.
+            Recorder* recorder = nullptr; // records everything done to the handler. Not owned by the handler.
+            int reservedContacts = 0; // capacity of each collision list set through reserve. 0 = sized by the number of bodies.
+            int memoryOverflows = 0; // number of times a step ran out of memory during the last call to update
             float updateStep; // amount of dt to update after
             static const int IMPULSE_ITERATIONS = 6; // number of times to apply the impulse update.
+            static const int BULLET_SUBSTEPS = 4; // max number of times a bullet can hit something in a single step.
 
 
             // * ==============================
@@ -161,6 +383,110 @@ namespace Zeta {
             void addCollision(KinematicBody2D* kb1, KinematicBody2D* kb2, CollisionManifold const &manifold);
             void clearCollisions();
 
+            // Resolve a contact with either a speculative or a regular impulse.
+            template <typename A, typename B>
+            inline void resolveContact(A* a, B* b, CollisionManifold const &manifold) {
+                if (!manifold.numPoints) { applySpeculativeImpulse(a, b, manifold, updateStep); }
+                else { applyImpulse(a, b, manifold); }
+            };
+
+            // Record an overlap between a sensor and another body for the current step.
+            void addSensorPair(BodyRef const &sensor, BodyRef const &other);
+
+            // Diff the sensor overlaps of the current step against the previous step to generate sensor events.
+            void updateSensorEvents();
+
+            // Report the sensor overlaps ended by removing one of their bodies as exits.
+            void addRemovedSensorEvents();
+
+            // Diff the contact of one colliding pair against the previous step and queue the resulting event.
+            void addContactEvent(BodyRef const &body1, BodyRef const &body2, CollisionManifold const &manifold);
+
+            // Diff the contacts of the current step against the previous step and publish the contact events.
+            void updateContactEvents();
+
+            // Determine if a contact from the previous step was not collided on the current step because of level of detail.
+            // lod.skipped must be sorted.
+            bool isContactSkipped(BodyRef const &body1, BodyRef const &body2) const;
+
+            // Forget any sensor overlaps, contacts, and sensor events involving a body that is being removed.
+            // Its sensor overlaps are kept aside to be reported as exits by the next update.
+            void removeBodyPairs(void* body);
+
+            // Forget any sensor overlaps, contacts, and sensor events involving the bodies removed(body) returns 1 for.
+            // Their sensor overlaps are kept aside to be reported as exits by the next update.
+            template <typename F>
+            void removeBodyPairsIf(F const &removed);
+
+            // Make sure n rigid bodies fit without reallocating.
+            void reserveRigidBodies(int n);
+
+            // Get the pool a rigid body lives in. -1 = it is not pooled.
+            int findRigidBodyPool(RigidBody2D const* rb) const;
+
+            // Get the index of a rigid body. -1 = it is not in the handler.
+            int findRigidBody(RigidBody2D const* rb) const;
+
+            // Tell the body's pool (if any) that it now lives at index i.
+            void setRigidBodyIndex(RigidBody2D const* rb, int i);
+
+            // Return a rigid body to its pool or free it if it is not pooled.
+            void freeRigidBody(RigidBody2D* rb);
+
+            // Despawn the rigid body at index i without forgetting its pairs.
+            void despawnRigidBodyAt(int i);
+
+            // Sort the rigid bodies along a Morton curve through their positions.
+            void reorderRigidBodies();
+
+            // Check whether a step has to make do with the memory it already has.
+            inline bool fixedMemory() const { return memoryLimitMode != GROW_MEMORY; };
+
+            // Called when a step drops something because it may not allocate. Throws if memoryLimitMode is THROW_ON_OVERFLOW.
+            void dropOverflow();
+
+            // Rebuild the static bodies' broadphase structure if the static bodies changed.
+            void updateStaticTree();
+
+            // Rebuild the broadphase structures if the bodies in them changed.
+            void updateTrees();
+
+            // Integrate a bullet while sweeping it against the static and kinematic bodies.
+            void updateBullet(RigidBody2D* rb, float dt);
+
+            // Determine how many steps apart each rigid body is stepped during this call to update.
+            void updateLODIntervals();
+
+            // Determine if the rigid body at index i is stepped on the current step.
+            inline bool isStepped(int i) const { return !lod.enabled || lod.stepped[i]; };
+
+            // Get the dt the rigid body at index i is integrated with on the current step. 0 if it is not stepped.
+            inline float getStepLength(int i) const { return !lod.enabled ? updateStep : lod.stepped[i] ? updateStep * lod.intervals[i] : 0.0f; };
+
+            // Find the bodies in each observer's view and generate events for the ones that entered or left it.
+            void updateObservers();
+
+            // Query an observer's whole view and diff it against the bodies it could see during the previous step.
+            void queryObserver(int observer);
+
+            // Carry an observer's visible bodies over from the previous step, only testing the bodies in observedBounds.changed.
+            void refreshObserver(int observer);
+
+            // Fill observedBounds.changed with the bodies whose bounds differ from the stored ones.
+            void findChangedBounds();
+
+            // Add a visibility event. Events past the reserved memory are dropped under a fixed memoryLimitMode.
+            void addVisibilityEvent(VisibilityEvent const &event);
+
+            // Record the settings if they changed since they were last recorded.
+            void recordSettings();
+
+            // Record a call to update along with the forces going into it.
+            void recordUpdate(float dt);
+
+            // Store the current positions of the rigid and kinematic bodies as the start (previous = 1) or end of the last step.
+            void storePositions(bool previous);
+
         public:
             // * =====================
             // * Public Attributes
@@ -168,6 +494,38 @@ namespace Zeta {
 
             ZMath::Vec2D g; // gravity
 
+            // ? When dt piles up (e.g. after a hitch), update would run many steps back to back and make the next frame even later.
+            // ? These limit how much work a single call to update can do.
+
+            int maxSteps = 0; // max number of steps per call to update. 0 = no limit.
+            float stepBudget = 0.0f; // max wall clock time in seconds to spend stepping per call to update. 0 = no limit. Not deterministic.
+            StepLimitMode stepLimitMode = DROP_TIME; // what to do once either limit is hit
+
+            // ? Level of detail lets far away or unimportant rigid bodies be stepped less often.
+            // ? A body in tier t is integrated and collided every lodIntervals[t] steps with dt scaled to match.
+            // ?  Steps are staggered between bodies so the work is spread out evenly.
+            // ? Pairs are collided when either body is stepped. Sensor overlaps are still checked every step.
+            // ? Contacts of pairs that are not collided on a step carry over without an event until the pair is collided again.
+
+            int lodIntervals[LOD_TIERS] = {1, 2, 4, 8}; // steps between updates for each tier. Must be at least 1.
+
+            // ? Once reserve has been called, a step only allocates when something grows past what was reserved.
+            // ? Set this to DROP_OVERFLOW or THROW_ON_OVERFLOW to guarantee update never allocates.
+
+            MemoryLimitMode memoryLimitMode = GROW_MEMORY; // what a step does when it needs more memory
+
+            // Generate contacts for rigid bodies that are not touching yet, but will be by the end of the step at their current velocities.
+            // These keep fast bodies from tunneling without the cost of bullets, but can make bodies stop just short of each other.
+            bool speculativeContacts = 0;
+
+            // ? Rigid bodies are stored in the order they were added, so bodies that are close in the world can be far apart in the list.
+            // ? Reordering sorts them along a Morton (Z order) curve through their positions so neighbors end up next to each other.
+            // ? It runs at the start of every step that is a multiple of reorderInterval, so replays and rollbacks reorder at the same steps.
+            // ? Reordering changes the index of the rigid bodies (getRigidBody, replication, and interpolated positions), but never moves
+            // ?  the bodies themselves. Hold on to the RigidBody2D pointers to refer to a body across reorders.
+
+            int reorderInterval = 0; // steps between reorders. 0 = never.
+
 
             // * ===================================
             // * Constructors, Destructors, Etc.
@@ -175,14 +533,20 @@ namespace Zeta {
 
             // Make a physics handler with a default gravity of -9.8 and an update speed of 60FPS.
 
+            // ? Ownership of the bodies follows the memory resource: the handler frees every body it holds through its resource.
+            // ?  Without a resource bodies are freed with delete, so they must be made with new.
+            // ?  With one they must come from that resource, which the create functions take care of.
+            // ? The resource must outlive the handler.
+
             /**
              * @brief Create a physics handler.
              * 
              * @param g (Vec3D) The force applied by gravity. Default of <0, 0, -9.8f>.
              * @param timeStep (float) The amount of time in seconds that must pass before the handler updates physics.
              *    Default speed of 60FPS. Anything above 60FPS is not recommended as it can cause lag in lower end hardware.
+             * @param resource Where the bodies and internal arrays are allocated from. Default of nullptr uses new and delete.
              */
-            Handler(ZMath::Vec2D const &g = ZMath::Vec2D(0, -9.8f), float timeStep = FPS_60);
+            Handler(ZMath::Vec2D const &g = ZMath::Vec2D(0, -9.8f), float timeStep = FPS_60, std::pmr::memory_resource* resource = nullptr);
 
             // Do not allow for construction from an existing physics handler.
             Handler(Handler const &handler);
@@ -194,36 +558,98 @@ namespace Zeta {
 
             ~Handler();
 
+            // Get the memory resource bodies added to the handler must come from. nullptr = new and delete.
+            inline std::pmr::memory_resource* getMemoryResource() const { return resource; };
+
 
             // * ============================
             // * RigidBody List Functions
             // * ============================
 
+            // Get the number of rigid bodies in the handler.
+            inline int getRigidBodyCount() const { return rbs.count; };
+
+            // Get the rigid body at an index. Bodies are stored in the order they were added.
+            inline RigidBody2D* getRigidBody(int i) const { return rbs.rigidBodies[i]; };
+
+            // Get a counter that changes whenever a body is added or removed or a rigid body changes index.
+            // Anything that refers to rigid bodies by index must be rebuilt when it changes.
+            inline unsigned int getBodyIndexGeneration() const { return bodyIndexGeneration; };
+
             // Add a rigid body to the list of rigid bodies to be updated.
             void addRigidBody(RigidBody2D* rb);
 
             // Add a list of rigid bodies to the handler.
             void addRigidBodies(RigidBody2D** rbs, int size);
 
+            // Make a rigid body with the handler's memory resource and add it to the handler.
+            // Takes the same arguments as the RigidBody2D constructor.
+            RigidBody2D* createRigidBody(ZMath::Vec2D const &pos, float mass, float cor, float linearDamping, RigidBodyCollider colliderType, void* collider);
+
             // Remove a rigid body from the handler.
             // 1 = rigid body was found and removed. 0 = It was not found.
-            // rb will be deleted if the rigid body was found.
+            // rb will be freed (or returned to its pool) if the rigid body was found.
             bool removeRigidBody(RigidBody2D* rb);
 
 
+            // * ============================
+            // * RigidBody Pools
+            // * ============================
+
+            // ? Pools let rigid bodies be spawned and despawned without touching the heap.
+            // ? Spawning copies a body into a free slot and appends it in O(1). Despawning moves the last rigid body into its place,
+            // ?  so despawns change the order of the rigid bodies. Use removeRigidBody to keep the order.
+            // ? Despawning is not O(1): the body's sensor overlaps, contacts, and pending events are forgotten with a pass over
+            // ?  every pair and event, which is O(pairs + events) per call. Use despawnRigidBodies to pay for that pass once per batch.
+
+            // Create a pool with room for capacity rigid bodies and reserve room for them in the handler.
+            // Returns the id of the pool. Pools are freed with the handler.
+            int createRigidBodyPool(int capacity);
+
+            // Get the number of bodies that can still be spawned from a pool.
+            inline int getRigidBodyPoolFree(int pool) const { return rigidPools.pools[pool].freeCount; };
+
+            // Copy body into a free slot of a pool and add it to the handler.
+            // Returns the spawned body or nullptr if the pool is full.
+            RigidBody2D* spawnRigidBody(int pool, RigidBody2D const &body);
+
+            // Spawn count bodies from a pool. The spawned bodies are written to spawned if it is not nullptr.
+            // Returns the number of bodies spawned, which is less than count if the pool runs out.
+            int spawnRigidBodies(int pool, RigidBody2D const* bodies, int count, RigidBody2D** spawned = nullptr);
+
+            // Remove a rigid body by moving the last rigid body into its place. Pooled bodies go back to their pool.
+            // Pooled bodies are found in O(1) and other bodies are searched for, then the body's pairs are forgotten in O(pairs + events).
+            // 1 = rigid body was found and removed. 0 = It was not found.
+            bool despawnRigidBody(RigidBody2D* rb);
+
+            // Despawn a list of rigid bodies, forgetting their pairs in a single O((pairs + events) * log(count)) pass.
+            // Returns the number of bodies despawned.
+            int despawnRigidBodies(RigidBody2D* const* rbs, int count);
+
+
             // * ============================
             // * StaticBody List Functions
             // * ============================
 
+            // Get the number of static bodies in the handler.
+            inline int getStaticBodyCount() const { return sbs.count; };
+
+            // Get the static body at an index. Bodies are stored in the order they were added.
+            inline StaticBody2D* getStaticBody(int i) const { return sbs.staticBodies[i]; };
+
             // Add a static body to the handler.
             void addStaticBody(StaticBody2D* sb);
 
             // Add a list of static bodies to the handler.
             void addStaticBodies(StaticBody2D** sbs, int size);
 
+            // Make a static body with the handler's memory resource and add it to the handler.
+            // Takes the same arguments as the StaticBody2D constructor.
+            StaticBody2D* createStaticBody(ZMath::Vec2D const &pos, StaticBodyCollider colliderType, void* collider);
+
             // Remove a static body from the handler.
             // 1 = static body was found and removed. 0 = It was not found.
-            // sb will be deleted if the static body was found.
+            // sb will be freed if the static body was found (unless it was loaded from a scene).
             bool removeStaticBody(StaticBody2D* sb);
 
 
@@ -231,15 +657,25 @@ namespace Zeta {
             // * KinematicBody List Functions
             // * ================================
 
+            // Get the number of kinematic bodies in the handler.
+            inline int getKinematicBodyCount() const { return kbs.count; };
+
+            // Get the kinematic body at an index. Bodies are stored in the order they were added.
+            inline KinematicBody2D* getKinematicBody(int i) const { return kbs.kinematicBodies[i]; };
+
             // Add a kinematic body to the handler.
             void addKinematicBody(KinematicBody2D* kb);
 
             // Add a list of kinematic bodies to the handler.
             void addKinematicBodies(KinematicBody2D** kbs, int size);
 
+            // Make a kinematic body with the handler's memory resource and add it to the handler.
+            // Takes the same arguments as the KinematicBody2D constructor.
+            KinematicBody2D* createKinematicBody(ZMath::Vec2D const &pos, KinematicBodyCollider colliderType, void* collider);
+
             // Remove a kinematic body from the handler.
             // 1 = kinematic body was found and removed. 0 = It was not found.
-            // kb will be deleted if the kinematic body was found.
+            // kb will be freed if the kinematic body was found.
             bool removeKinematicBody(KinematicBody2D* kb);
 
 
@@ -250,5 +686,261 @@ namespace Zeta {
             // Update the physics.
             // dt will be updated to the appropriate value after the updates run for you so DO NOT modify it yourself.
             int update(float &dt);
+
+            // Get how much simulation time the last call to update skipped because of maxSteps or stepBudget.
+            inline float getSkippedTime() const { return skippedTime; };
+
+            // Set the regions where rigid bodies are always stepped at the full rate, such as the areas around players.
+            // This replaces any regions set before. The regions are copied.
+            void setActiveRegions(AABB const* regions, int count);
+
+
+            // * ======================
+            // * Frame Memory
+            // * ======================
+
+            // ? The collisions found during a step live in a frame arena that is reset at the end of the step.
+            // ? It only allocates while growing to fit the busiest step seen so far. Measure the peak during a
+            // ?  representative run and pass it to reserveFrameMemory at startup to skip that warm up entirely.
+
+            // Get the most bytes the collisions of a single step have needed so far.
+            inline size_t getFrameMemoryPeak() const { return frameArena.getPeak(); };
+
+            // Preallocate enough memory for the collisions of a step needing up to bytes.
+            void reserveFrameMemory(size_t bytes);
+
+
+            // * ======================
+            // * Reserved Memory
+            // * ======================
+
+            // ? reserve sizes everything update uses, so with a memoryLimitMode other than GROW_MEMORY update never allocates.
+            // ? Call it after enabling contact events and adding the observers since their arrays are only sized if they exist.
+            // ? Adding bodies, observers, and pools still allocates as usual, as does recording.
+
+            /**
+             * @brief Preallocate everything a step needs.
+             *
+             * @param maxBodies Most rigid and kinematic bodies in the handler at once.
+             * @param maxContacts Most contacts of each kind (rigid-rigid, rigid-static, rigid-kinematic, kinematic-static,
+             *    and kinematic-kinematic) in a single step. Also used for the sensor overlaps and contact events.
+             *    Each collision list is fixed to this size from now on, so contacts past it are dropped under a fixed memoryLimitMode.
+             * @param maxVisible Most bodies visible to all of the observers combined in a single step. A body seen by two observers
+             *    counts twice. 0 = maxBodies plus the static bodies currently in the handler, which fits observers that each see
+             *    a different part of the world. Bodies past it are dropped under a fixed memoryLimitMode.
+             */
+            void reserve(int maxBodies, int maxContacts, int maxVisible = 0);
+
+            // Get how many contacts, sensor overlaps, events, and views were cut short during the last call to update
+            //  because the handler was not allowed to allocate.
+            inline int getMemoryOverflows() const { return memoryOverflows; };
+
+
+            // * ======================
+            // * Recording
+            // * ======================
+
+            // Start recording everything done to the handler (see recorder.h). Pass nullptr to stop recording.
+            // The current settings and bodies are recorded first so the recording replays into an empty handler.
+            // The handler does not take ownership of the recorder.
+            void setRecorder(Recorder* recorder);
+
+
+            // * ======================
+            // * Scenes
+            // * ======================
+
+            // ? A scene is a binary file holding the static bodies and their prebuilt BVH (see scene.h).
+            // ? Loading maps the file and uses the bodies and tree in place, so large levels start without building anything.
+            // ? The static bodies of a loaded scene live in the mapping and stay valid until the handler is destroyed.
+
+            // Write every static body in the handler and the static BVH over them to a scene file.
+            // 1 = the file was written. 0 = it could not be written.
+            bool saveScene(char const* path);
+
+            // Load the static bodies of a scene file into the handler. Only one scene can be loaded per handler.
+            // The prebuilt BVH is used as is when the handler has no static bodies yet. Otherwise it is rebuilt on the next step.
+            // 1 = the scene was loaded. 0 = a scene is already loaded or the file is not a valid scene for this build.
+            bool loadScene(char const* path);
+
+
+            // * ======================
+            // * Snapshots
+            // * ======================
+
+            // ? A snapshot is a flat copy of every rigid and kinematic body (including their colliders) in the order they are stored in the handler.
+            // ? Static bodies are not part of a snapshot since they never move. Restoring leaves them and the static broadphase as they are.
+            // ? The order of the rigid bodies is restored too, so snapshots stay valid across reorders.
+            // ? Restoring only works while the handler has the same bodies it had when the snapshot was saved, which is
+            // ?  what rollback netcode needs: save every frame, then restore and re-simulate on a misprediction.
+            // ? Adding, removing, spawning, or despawning any body (even one added back in its place) makes older snapshots
+            // ?  unrestorable. Reordering and restoring do not.
+            // ? Sensor and contact event state is not part of a snapshot.
+
+            // Get the number of bytes needed to save a snapshot of the current bodies.
+            size_t getSnapshotSize() const;
+
+            // Save a snapshot of every rigid and kinematic body into buffer.
+            // Returns the number of bytes written or 0 if capacity is too small.
+            size_t saveSnapshot(void* buffer, size_t capacity) const;
+
+            // Restore every rigid and kinematic body from a snapshot saved by this handler.
+            // 1 = the snapshot was restored. 0 = bodies were added or removed since it was saved and nothing was changed.
+            bool restoreSnapshot(void const* buffer, size_t size);
+
+
+            // * ======================
+            // * Checksums
+            // * ======================
+
+            // ? Compare checksums between peers (or against a recording) after each step to catch a desync the step it happens.
+            // ? Only the state stepping changes is hashed: the step count and the position and velocity of every rigid and kinematic body.
+            // ? Checksums only match across platforms when built with ZETA_DETERMINISTIC (see zmath2D.h).
+
+            // Get a checksum of the current state of the world.
+            unsigned long long getChecksum() const;
+
+
+            // * ============================
+            // * Render Interpolation
+            // * ============================
+
+            // ? update leaves the time that did not fill a whole step in dt. Rendering the bodies where they were that far
+            // ?  between the last two steps keeps motion smooth when rendering faster than the physics steps.
+
+            // Get how far between the last two steps the leftover dt reaches. 0 = at the start of the last step, 1 = at its end.
+            inline float getInterpolationAlpha() const { return alpha; };
+
+            // Fill positions with the interpolated position of every rigid body followed by every kinematic body,
+            //  each in the order they are stored in the handler.
+            // If any body was added, removed, spawned, despawned, reordered, or restored from a snapshot since the last step,
+            //  every body is written at its current position until the next step.
+            // Returns the number of positions written, which is at most capacity.
+            int getInterpolatedPositions(ZMath::Vec2D* positions, int capacity) const;
+
+
+            // * ======================
+            // * Sensor Functions
+            // * ======================
+
+            // Get the sensor events generated during the last call to update in the order they occurred.
+            // count will be set to the number of events.
+            // The events are only valid until the next call to update or until one of the bodies involved is removed.
+            // Removing a body ends its overlaps, and the next call to update reports them as SENSOR_EXIT before its other events.
+            // The removed body in those events is only good for comparing against pointers held from before the removal.
+            inline SensorEvent const* getSensorEvents(int &count) const {
+                count = sensorEvents.count;
+                return sensorEvents.events;
+            };
+
+
+            // * ======================
+            // * Observers
+            // * ======================
+
+            // ? An observer is a view rectangle (e.g. what a connected client can see) whose visible bodies are kept up to date.
+            // ? After each call to update that steps, views that were added or moved are queried through the broadphase and
+            // ?  diffed against the previous step. Views that stayed put keep their visible bodies and only re-test the rigid and
+            // ?  kinematic bodies whose bounds crossed one of their edges, so a still camera over a mostly sleeping world costs little.
+            // ? Adding or removing bodies, despawning, reordering, and restoring a snapshot make every view get queried again once.
+            // ? Static, rigid, and kinematic bodies (including sensors) are reported. Removing a body drops it without an event.
+
+            // Add an observer. Its visible bodies are found during the next call to update that steps.
+            // Returns the id of the observer. Ids of removed observers are reused.
+            int addObserver(AABB const &view);
+
+            // Move an observer's view. Bodies entering or leaving it are reported during the next call to update that steps.
+            void setObserverView(int observer, AABB const &view);
+
+            // Remove an observer. No events are generated for the bodies it could see.
+            void removeObserver(int observer);
+
+            // Get the bodies an observer could see at the end of the last call to update that stepped.
+            // Returns the number of bodies written to bodies. Bodies past capacity are dropped.
+            int getVisibleBodies(int observer, BodyRef* bodies, int capacity) const;
+
+            // Get the visibility events generated during the last call to update in the order they occurred.
+            // count will be set to the number of events.
+            // The events are only valid until the next call to update or until one of the bodies involved is removed.
+            inline VisibilityEvent const* getVisibilityEvents(int &count) const {
+                count = visibilityEvents.count;
+                return visibilityEvents.events;
+            };
+
+            // Get the number of body against view tests made for views that did not move during the last call to update that stepped.
+            // This is the number of bodies whose bounds changed times the number of such views, so it is 0 while nothing moves.
+            inline int getObserverBodyTests() const { return observerBodyTests; };
+
+
+            // * ==============================
+            // * Contact Event Functions
+            // * ==============================
+
+            // Start generating contact begin/persist/end events each step.
+            // capacity is the max number of unread events and is rounded up to a power of 2. Events that do not fit are dropped.
+            // The queue is allocated here and never grows. Calling this again replaces the queue so it must not be drained at the time.
+            void enableContactEvents(int capacity = 1024);
+
+            // Get the queue contact events are published to after each step.
+            // A single other thread may drain it while the handler keeps stepping.
+            // Returns nullptr if contact events have not been enabled.
+            inline ContactEventQueue* getContactEvents() const { return contactEvents; };
+
+
+            // * =====================
+            // * World Queries
+            // * =====================
+
+            // ? World queries traverse the broadphase structures, which are brought up to date lazily by the first query after the bodies change.
+            // ? When bodies only move, the dynamic tree is refitted from the bounds cached in the bodies in linear time. It is only
+            // ?  rebuilt when bodies are added or removed, or once refitting has made it more than BVH_REFIT_LIMIT times as costly to traverse.
+            // ? If you move bodies yourself between calls to update, call updateBounds on them and then invalidateBroadphase before querying.
+
+            // Let the handler know bodies were moved outside of update.
+            inline void invalidateBroadphase() { dynamicTreeMoved = 1; };
+
+            // Find the closest body hit by a ray. Sensors are ignored.
+            // 1 = hit was set to the closest hit within maxDist. 0 = nothing was hit.
+            bool raycast(Ray2D const &ray, RaycastHit &hit, float maxDist = FLT_MAX);
+
+            // Find any body hit by a ray. This is cheaper than raycast when only line of sight matters. Sensors are ignored.
+            // 1 = hit was set to a hit within maxDist. 0 = nothing was hit.
+            bool raycastAny(Ray2D const &ray, RaycastHit &hit, float maxDist = FLT_MAX);
+
+            // Find every body hit by a ray sorted from closest to farthest. Sensors are ignored.
+            // If there are more than capacity hits, only the closest are kept.
+            // Returns the number of hits written to hits.
+            int raycastAll(Ray2D const &ray, RaycastHit* hits, int capacity, float maxDist = FLT_MAX);
+
+            // Find the closest body hit by each ray in a batch. Sensors are ignored.
+            // Rays are traced in packets of RAY_PACKET_SIZE, so neighbouring rays should be coherent (e.g. fans from one origin).
+            // hits[i] is set to the closest hit of rays[i] within maxDist. If rays[i] hits nothing, hits[i].body.body is set to nullptr.
+            // Returns the number of rays that hit something.
+            int raycast(Ray2D const* rays, int count, RaycastHit* hits, float maxDist = FLT_MAX);
+
+            // ? Region queries write into a caller provided buffer and never allocate, so they are safe to call between steps.
+            // ? Sensors are included. If more than capacity bodies overlap the region, the rest are dropped.
+
+            // Find every body overlapping an AABB. Returns the number of bodies written to bodies.
+            int queryAABB(AABB const &aabb, BodyRef* bodies, int capacity);
+
+            // Find every body overlapping a circle. Returns the number of bodies written to bodies.
+            int queryCircle(Circle const &circle, BodyRef* bodies, int capacity);
+
+            // Find every body overlapping a Box2D. Returns the number of bodies written to bodies.
+            int queryBox(Box2D const &box, BodyRef* bodies, int capacity);
+
+            // ? Shape casts sweep a primitive along a normalized direction and find the first body it touches. Sensors are ignored.
+            // ? hit.dist is how far the shape can move before touching the body. It is 0 if the shape starts out overlapping a body it is not moving out of.
+            // ? Pass the body the shape belongs to as ignore so it does not hit itself.
+
+            // Sweep a circle through the world. 1 = hit was set to the first hit within maxDist. 0 = nothing was hit.
+            bool shapecast(Circle const &circle, ZMath::Vec2D const &dir, ShapecastHit &hit, float maxDist = FLT_MAX, void const* ignore = nullptr);
+
+            // Sweep an AABB through the world. 1 = hit was set to the first hit within maxDist. 0 = nothing was hit.
+            bool shapecast(AABB const &aabb, ZMath::Vec2D const &dir, ShapecastHit &hit, float maxDist = FLT_MAX, void const* ignore = nullptr);
+
+            // Sweep a Box2D through the world. 1 = hit was set to the first hit within maxDist. 0 = nothing was hit.
+            bool shapecast(Box2D const &box, ZMath::Vec2D const &dir, ShapecastHit &hit, float maxDist = FLT_MAX, void const* ignore = nullptr);
     };
 }
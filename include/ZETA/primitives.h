@@ -74,6 +74,9 @@ namespace Zeta {
             // Get the vertices of the AABB.
             // Remember to call delete[] on what you assign this to afterwards to free the memory.
             ZMath::Vec2D* getVertices() const;
+
+            // Fill v with the vertices of the AABB without allocating.
+            void getVertices(ZMath::Vec2D v[4]) const;
     };
 
     class Box2D {
@@ -106,5 +109,8 @@ namespace Zeta {
             // Get the vertices of the Box2D in terms of global coordinates.
             // Remeber to use delete[] on the variable you assign this after use to free the memory.
             ZMath::Vec2D* getVertices() const;
+
+            // Fill v with the vertices of the Box2D in terms of global coordinates without allocating.
+            void getVertices(ZMath::Vec2D v[4]) const;
     };
 }
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "bodies.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Zeta {
+    class Handler;
+
+    // * ========================
+    // * Recordings
+    // * ========================
+
+    // ? A recording is a compact binary log of everything a handler was told to do: its settings, every body added or removed,
+    // ?  the forces on the rigid bodies going into each update, and the dt passed to each update.
+    // ? Replaying it into a fresh handler with replayRecord (see tools/replay.cpp) reproduces the same steps, so slow frames
+    // ?  reported from a game can be profiled offline.
+    // ? Everything is little-endian and bodies are stored as raw bytes, so a recording only replays on builds with the same body layout.
+    // ? Bodies are referred to by their index in the handler. Direct edits to body positions or velocities are not recorded.
+
+    // Bump this whenever the layout of a recording changes. Changes to the layout of the bodies are caught by their sizes.
+    static const uint32_t RECORDING_VERSION = 1;
+
+    // Type of each record in a recording.
+    enum RecordType {
+        RECORD_SETTINGS, // the handler's settings changed (always the first record)
+        RECORD_ADD_BODY, // a body was added
+        RECORD_REMOVE_BODY, // the body at an index was removed
+        RECORD_FORCE, // the net force on the rigid body at an index going into the next update
+        RECORD_ACTIVE_REGIONS, // the active regions were replaced
+        RECORD_UPDATE, // update was called
+        RECORD_DESPAWN_BODY // the rigid body at an index was despawned (see Handler::despawnRigidBody)
+    };
+
+    // Settings of a handler that affect stepping.
+    struct RecordSettings {
+        ZMath::Vec2D g;
+        float updateStep; // only read from the first settings record since it cannot change after construction
+        float stepBudget;
+        int maxSteps;
+        int stepLimitMode;
+        int lodIntervals[4];
+        int reorderInterval;
+        bool speculativeContacts;
+    };
+
+    // A record read back from a recording.
+    // ? Pointers point into the recording so they stay valid as long as the recording does.
+    struct Record {
+        RecordType type;
+        BodyType bodyType; // RECORD_ADD_BODY and RECORD_REMOVE_BODY
+        int index; // RECORD_REMOVE_BODY, RECORD_DESPAWN_BODY, and RECORD_FORCE. Number of regions for RECORD_ACTIVE_REGIONS.
+        ZMath::Vec2D force; // RECORD_FORCE
+        float dt; // RECORD_UPDATE
+        RecordSettings settings; // RECORD_SETTINGS
+        void const* body; // RECORD_ADD_BODY. Raw bytes of the body. Copy it before using it.
+        void const* regions; // RECORD_ACTIVE_REGIONS. Raw bytes of the region bounds (min then max of each region).
+    };
+
+    // Writes records into a growing in memory buffer.
+    class Recorder {
+        private:
+            char* data = nullptr;
+            size_t capacity = 0;
+            size_t size = 0;
+
+            RecordSettings settings; // last settings written
+            bool hasSettings = 0;
+
+            // Make room for n more bytes.
+            void reserve(size_t n);
+
+            // Append raw bytes.
+            void write(void const* bytes, size_t n);
+
+        public:
+            // Create an empty recording.
+            Recorder();
+
+            // The recorder owns its buffer.
+            Recorder(Recorder const &recorder) = delete;
+            Recorder& operator = (Recorder const &recorder) = delete;
+
+            ~Recorder();
+
+            // Remove every record.
+            void clear();
+
+            inline char const* getData() const { return data; };
+            inline size_t getSize() const { return size; };
+
+            // Write the recording to a file.
+            // 1 = the file was written. 0 = it could not be written.
+            bool save(char const* path) const;
+
+            // * Called by the handler while this recorder is attached to it.
+
+            // Record the settings if they changed since they were last recorded.
+            void recordSettings(RecordSettings const &settings);
+
+            void recordAdd(BodyType type, void const* body);
+            void recordRemove(BodyType type, int index);
+            void recordDespawn(int index);
+            void recordForce(int index, ZMath::Vec2D const &force);
+            void recordActiveRegions(ZMath::Vec2D const* mins, ZMath::Vec2D const* maxes, int count);
+            void recordUpdate(float dt);
+    };
+
+    // Reads the records of a recording in order.
+    class RecordReader {
+        private:
+            char const* data = nullptr;
+            size_t size = 0;
+            size_t offset = 0;
+
+        public:
+            inline RecordReader() {};
+
+            // Start reading a recording. It is not copied so it must stay valid while reading.
+            // 1 = the recording is valid for this build. 0 = it is not.
+            bool open(void const* data, size_t size);
+
+            // Read the next record.
+            // 1 = a record was read. 0 = the end of the recording was reached or the record is malformed.
+            bool next(Record &record);
+    };
+
+    // Do what a record says was done to the recorded handler. Added bodies are copied onto the heap for the handler to own.
+    // A handler replaying a recording should be constructed with the g and updateStep of its first record.
+    // Returns the number of steps taken for RECORD_UPDATE and 0 for every other record.
+    int replayRecord(Handler &handler, Record const &record);
+}
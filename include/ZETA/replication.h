@@ -0,0 +1,127 @@
+#pragma once
+
+#include "physicshandler.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Zeta {
+    // * ========================
+    // * Replication
+    // * ========================
+
+    // ? The encoder sends each client the change in every rigid body's position and velocity since the last packet
+    // ?  sent to that client (its baseline). Bodies that did not change are skipped entirely.
+    // ? Values are quantized to a fixed precision first, so bodies at rest stop costing anything and the deltas are small integers.
+    // ? Deltas are zigzag encoded and bit packed with a 2 bit size class, so a small delta costs 8 bits instead of 32.
+    // ? Baselines assume packets arrive in order. Call resetClient to send a full state after a client loses a packet.
+    // ? The encoder and decoder must be created with the same precision.
+    // ?
+    // ? Bodies are matched by their index in the handler, not by identity. Removing or despawning a body moves other bodies
+    // ?  to new indices, and reordering (Handler::reorderInterval) moves all of them. When capture sees that the handler's
+    // ?  body indices changed (Handler::getBodyIndexGeneration), every client's next packet is a full resend that replaces the
+    // ?  decoder's state instead of patching it, since deltas against another body's baseline would be meaningless.
+    // ? The body at a given index on the client is then a different body than before. The game must send its own mapping from
+    // ?  index to entity alongside that packet (or avoid changing indices while clients are connected).
+
+    // A rigid body's position and velocity in units of the precision.
+    struct QuantizedState {
+        int32_t px, py;
+        int32_t vx, vy;
+    };
+
+    // Quantized states of a list of bodies.
+    struct QuantizedStates {
+        QuantizedState* states = nullptr;
+        int capacity = 0;
+        int count = 0;
+    };
+
+    // The baselines of every client of an encoder.
+    struct ReplicationClients {
+        QuantizedStates* baselines = nullptr; // the state each client last received
+        bool* active = nullptr; // the client has not been removed
+        int capacity = 0;
+        int count = 0;
+    };
+
+    // Writes delta compressed rigid body states for any number of clients.
+    class ReplicationEncoder {
+        private:
+            QuantizedStates current; // state captured at the current tick
+            ReplicationClients clients;
+
+            float invPosPrecision; // 1/posPrecision
+            float invVelPrecision; // 1/velPrecision
+
+            unsigned int generation = 0; // Handler::getBodyIndexGeneration at the last capture
+            bool captured = 0; // capture has been called at least once
+
+        public:
+            /**
+             * @brief Create a replication encoder.
+             *
+             * @param posPrecision Size of the smallest change in position that is sent. The decoder must use the same value.
+             * @param velPrecision Size of the smallest change in velocity that is sent. The decoder must use the same value.
+             */
+            ReplicationEncoder(float posPrecision = 0.01f, float velPrecision = 0.01f);
+
+            // The encoder owns its baselines.
+            ReplicationEncoder(ReplicationEncoder const &encoder) = delete;
+            ReplicationEncoder& operator = (ReplicationEncoder const &encoder) = delete;
+
+            ~ReplicationEncoder();
+
+            // Add a client. Its first packet contains every body that is not at rest at the origin.
+            // Returns the id of the client.
+            int addClient();
+
+            // Remove a client. Its id is reused by the next call to addClient.
+            void removeClient(int client);
+
+            // Forget what a client has received so its next packet contains every body.
+            void resetClient(int client);
+
+            // Quantize the current state of every rigid body in a handler. Call once per tick before encoding for the clients.
+            // If the handler's body indices changed since the last capture, every client is reset.
+            void capture(Handler const &handler);
+
+            // Write the changes since a client's baseline into buffer and make the captured state its new baseline.
+            // Returns the number of bytes written or 0 if capacity is too small (the baseline is left unchanged).
+            size_t encode(int client, void* buffer, size_t capacity);
+    };
+
+    // Reads the packets written by a ReplicationEncoder for a single client.
+    class ReplicationDecoder {
+        private:
+            QuantizedStates states;
+            QuantizedStates scratch; // packets are decoded into this first
+
+            float posPrecision;
+            float velPrecision;
+
+        public:
+            /**
+             * @brief Create a replication decoder.
+             *
+             * @param posPrecision Must match the precision of the encoder.
+             * @param velPrecision Must match the precision of the encoder.
+             */
+            ReplicationDecoder(float posPrecision = 0.01f, float velPrecision = 0.01f);
+
+            // The decoder owns its states.
+            ReplicationDecoder(ReplicationDecoder const &decoder) = delete;
+            ReplicationDecoder& operator = (ReplicationDecoder const &decoder) = delete;
+
+            ~ReplicationDecoder();
+
+            // Apply a packet. A full resend replaces every state instead of patching them.
+            // 1 = the packet was applied. 0 = the packet is malformed and the state was left unchanged.
+            bool decode(void const* buffer, size_t size);
+
+            // Get the number of bodies in the last packet.
+            inline int getBodyCount() const { return states.count; };
+
+            // Get the position and velocity of the body at an index.
+            void getState(int i, ZMath::Vec2D &pos, ZMath::Vec2D &vel) const;
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "broadphase.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Zeta {
+    // * ========================
+    // * Scene File Format
+    // * ========================
+
+    // ? A scene file stores static bodies and a prebuilt BVH over them so large levels load without building anything.
+    // ? Everything is little-endian and laid out exactly like it is in memory, so a mapped file can be used in place.
+    // ? Layout: SceneHeader, the static bodies, the bounds (min then max) of each body in the BVH, then the BVH nodes.
+    // ? The first itemCount bodies are the BVH's items in order. Bodies without a collider come after them.
+
+    // Bump this whenever the layout of the file or of any of the structs stored in it changes.
+    static const uint32_t SCENE_VERSION = 2;
+
+    struct SceneHeader {
+        char magic[4]; // "ZSCN"
+        uint32_t version; // SCENE_VERSION of the writer
+        uint32_t bodySize; // sizeof(StaticBody2D) of the writer
+        uint32_t nodeSize; // sizeof(BVHNode) of the writer
+        uint32_t bodyCount; // number of static bodies
+        uint32_t itemCount; // number of bodies in the BVH
+        uint32_t nodeCount; // number of BVH nodes
+        uint32_t reserved;
+        uint64_t bodiesOffset; // byte offsets from the start of the file
+        uint64_t boundsOffset;
+        uint64_t nodesOffset;
+        uint64_t size; // total size of the file in bytes
+    };
+
+    // A scene file mapped into memory.
+    // The mapping is private (copy on write), so the static bodies in it can be modified without touching the file.
+    class SceneFile {
+        private:
+            void* data = nullptr; // start of the mapping
+            size_t size = 0; // size of the mapping in bytes
+
+#ifdef _WIN32
+            void* file = nullptr; // file handle
+            void* mapping = nullptr; // file mapping handle
+#endif
+
+        public:
+            inline SceneFile() {};
+
+            // The scene owns its mapping.
+            SceneFile(SceneFile const &scene) = delete;
+            SceneFile& operator = (SceneFile const &scene) = delete;
+
+            ~SceneFile();
+
+            // Map a scene file and check that it was written by a compatible build.
+            // 1 = the file was mapped. 0 = it could not be opened or is not a valid scene. Anything mapped before is unmapped.
+            bool open(char const* path);
+
+            // Unmap the file.
+            void close();
+
+            inline SceneHeader const* getHeader() const { return (SceneHeader const*) data; };
+            inline StaticBody2D* getBodies() const { return (StaticBody2D*) ((char*) data + getHeader()->bodiesOffset); };
+            inline ZMath::Vec2D const* getBounds() const { return (ZMath::Vec2D const*) ((char*) data + getHeader()->boundsOffset); };
+            inline BVHNode const* getNodes() const { return (BVHNode const*) ((char*) data + getHeader()->nodesOffset); };
+
+            // Determine if a pointer lies inside of the mapping.
+            inline bool contains(void const* ptr) const { return data && ptr >= data && (char const*) ptr < (char const*) data + size; };
+    };
+
+    /**
+     * @brief Write static bodies and a BVH built over exactly those bodies to a scene file.
+     * 
+     * @param path Path of the file to write. It is replaced if it exists, so scenes mapped from it stay valid.
+     *    The file is written to path with ".tmp" appended first.
+     * @param bodies The static bodies to write.
+     * @param count Number of static bodies.
+     * @param tree A BVH built over every body in bodies that has a collider.
+     * @return (bool) 1 if the file was written. 0 otherwise.
+     */
+    extern bool writeScene(char const* path, StaticBody2D* const* bodies, int count, BVH const &tree);
+}
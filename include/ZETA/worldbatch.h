@@ -0,0 +1,93 @@
+#pragma once
+
+#include "physicshandler.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Zeta {
+    // * =====================
+    // * World Batch
+    // * =====================
+
+    // The handlers owned by a WorldBatch along with their per world state.
+    struct Worlds {
+        Handler** handlers = nullptr;
+        float* accumulators = nullptr; // leftover dt of each world between updates
+        float* times = nullptr; // wall clock time in seconds each world took during the last update
+        int* steps = nullptr; // number of steps each world took during the last update
+        int* order = nullptr; // world indices sorted from most to least bodies
+        int* bodies = nullptr; // number of bodies in each world when the last update started
+
+        int capacity = 0;
+        int count = 0;
+    };
+
+    // Steps many independent handlers across a shared pool of worker threads.
+    // ? Each world is only ever updated by one thread at a time, so the handlers themselves need no locking.
+    // ? Worlds are handed out largest first (by body count) and workers pull the next world as soon as they finish one,
+    // ?  which keeps the workers evenly loaded even when the worlds vary a lot in size.
+    class WorldBatch {
+        private:
+            Worlds worlds;
+
+            std::thread* workers = nullptr;
+            int workerCount = 0;
+
+            std::mutex mutex;
+            std::condition_variable start; // signals the workers that a new update started or that they should stop
+            std::condition_variable done; // signals the calling thread that a worker finished its part of the update
+            unsigned int generation = 0; // incremented every update so the workers can tell when a new one starts
+            int finished = 0; // number of workers done with the current update
+            bool stopping = 0;
+
+            std::atomic<int> next; // index into worlds.order of the next world to update
+            float stepDt = 0.0f; // dt added to every world during the current update
+
+            // Update worlds until there are none left in the current update.
+            void work();
+
+            // Main loop of each worker thread.
+            void workerLoop();
+
+        public:
+            /**
+             * @brief Create a batch of worlds.
+             * 
+             * @param threads Number of threads used to update the worlds, including the thread calling update.
+             *                  0 will use one per hardware thread.
+             */
+            WorldBatch(int threads = 0);
+
+            // The batch owns its threads and handlers.
+            WorldBatch(WorldBatch const &batch) = delete;
+            WorldBatch& operator = (WorldBatch const &batch) = delete;
+
+            // Stops the worker threads and deletes every handler in the batch.
+            ~WorldBatch();
+
+            // Add a handler to the batch. The batch takes ownership and will delete it.
+            // Returns the index of the world.
+            int addWorld(Handler* handler);
+
+            // Get the number of worlds in the batch.
+            inline int getWorldCount() const { return worlds.count; };
+
+            // Get the handler of a world.
+            inline Handler* getWorld(int world) const { return worlds.handlers[world]; };
+
+            // Get the number of threads used to update the worlds, including the calling thread.
+            inline int getThreadCount() const { return workerCount + 1; };
+
+            // Update every world by dt. Each world keeps its own leftover dt between updates.
+            // Blocks until every world is done. Do not touch any of the worlds from other threads while this runs.
+            void update(float dt);
+
+            // Get the wall clock time in seconds a world took during the last update.
+            inline float getWorldTime(int world) const { return worlds.times[world]; };
+
+            // Get the number of steps a world took during the last update.
+            inline int getWorldSteps(int world) const { return worlds.steps[world]; };
+    };
+}
@@ -1,6 +1,37 @@
 #pragma once
 
 #include <cmath>
+#include <cfloat>
+
+// * ============================================
+// * Deterministic Mode
+// * ============================================
+
+// ? Define ZETA_DETERMINISTIC (for the library and everything including it) to get bit-identical results for the same
+// ?  inputs on every run and every platform. This is what lockstep multiplayer and replay validation need.
+// ? In this mode trig is computed with basic arithmetic instead of the C runtime, floating point contraction (fused
+// ?  multiply-add) is disabled, and the BVH splits do not depend on how the standard library partitions.
+// ? GCC ignores the standard contraction pragma, so with GCC the library and all user code that shares the simulation
+// ?  (anything that computes positions, forces, or velocities fed into the handler) must be compiled with -ffp-contract=off.
+// ?  build.bat does this for the library when run as "build.bat deterministic". Otherwise a machine with FMA can round
+// ?  differently from one without and the simulations drift apart.
+
+#ifdef ZETA_DETERMINISTIC
+    #if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+        #error "ZETA_DETERMINISTIC cannot be used with fast math."
+    #endif
+
+    // excess precision (x87) rounds differently depending on when values are spilled to memory
+    #if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+        #error "ZETA_DETERMINISTIC requires floats to be evaluated in single precision (use SSE2 instead of x87)."
+    #endif
+
+    #if defined(_MSC_VER)
+        #pragma fp_contract(off)
+    #elif defined(__clang__)
+        #pragma STDC FP_CONTRACT OFF
+    #endif
+#endif
 
 namespace ZMath {
     // * ============================================
@@ -52,7 +83,7 @@ namespace ZMath {
             inline Vec2D(float i, float j) : x(i), y(j) {};
 
             // * Instantiate a copy of the Vec3D object passed in.
-            inline Vec2D(const Vec2D &vec) : x(vec.x), y(vec.y) {};
+            inline Vec2D(const Vec2D &vec) = default;
 
             // * ============================
             // * Functions
@@ -153,6 +184,10 @@ namespace ZMath {
     // * Clamp a Vec2D between a min and max vector.
     extern Vec2D clamp(const Vec2D &n, const Vec2D &min, const Vec2D &max);
 
+    // * Compute the sine and cosine of an angle in degrees.
+    // * With ZETA_DETERMINISTIC defined the results are the same on every platform.
+    extern void sinCos(float degrees, float &s, float &c);
+
 
     // * Class modeling a 2x2 Matrix stored in column major order.
     class Mat2D {
@@ -164,7 +199,7 @@ namespace ZMath {
             Mat2D();
 
             // Create a 2D matrix from another 2D matrix.
-            Mat2D (const Mat2D &mat);
+            Mat2D (const Mat2D &mat) = default;
 
             // Create a 2D matrix from 2 column vectors.
             Mat2D (const Vec2D &col1, const Vec2D &col2);
@@ -225,8 +260,8 @@ namespace ZMath {
             // * Generate the 2D rotation matrix given a specified angle.
             // * The angle should be in degrees.
             static Mat2D rotationMat(float theta) {
-                float s = sinf(TORADIANS(theta));
-                float c = cosf(TORADIANS(theta));
+                float s, c;
+                sinCos(theta, s, c);
 
                 return Mat2D(c, -s, s, c);
             };
@@ -0,0 +1,80 @@
+#include <ZETA/arena.h>
+
+namespace Zeta {
+    // * ========================
+    // * Frame Arena
+    // * ========================
+
+    // Round n up to a multiple of align (a power of 2).
+    static inline size_t alignUp(size_t n, size_t align) { return (n + align - 1) & ~(align - 1); };
+
+    // Allocate n bytes aligned to alignof(std::max_align_t).
+    static inline char* allocBytes(std::pmr::memory_resource* resource, size_t n) {
+        return resource ? (char*) resource->allocate(n, alignof(std::max_align_t)) : new char[n];
+    };
+
+    // Free n bytes allocated by allocBytes with the same resource.
+    static inline void freeBytes(std::pmr::memory_resource* resource, char* bytes, size_t n) {
+        if (!resource) { delete[] bytes; }
+        else if (bytes) { resource->deallocate(bytes, n, alignof(std::max_align_t)); }
+    };
+
+    FrameArena::~FrameArena() {
+        freeOverflow();
+        freeBytes(resource, data, capacity);
+    };
+
+    void FrameArena::freeOverflow() {
+        while (overflow) {
+            ArenaBlock* next = overflow->next;
+            freeBytes(resource, (char*) overflow, overflow->size);
+            overflow = next;
+        }
+    };
+
+    void* FrameArena::allocate(size_t size, size_t align) {
+        // ? frameBytes is where the allocation would end if every allocation since the last reset had fit in the buffer,
+        // ?  so growing the buffer to the peak guarantees the same step fits next time.
+        frameBytes = alignUp(frameBytes, align) + size;
+        if (frameBytes > peak) { peak = frameBytes; }
+
+        size_t offset = alignUp(used, align);
+
+        if (offset + size <= capacity) {
+            used = offset + size;
+            return data + offset;
+        }
+
+        // the data of a block is aligned to alignof(std::max_align_t) so it works for any alignment
+        size_t blockSize = offsetof(ArenaBlock, data) + size;
+
+        ArenaBlock* block = (ArenaBlock*) allocBytes(resource, blockSize);
+        block->next = overflow;
+        block->size = blockSize;
+        overflow = block;
+
+        return block->data;
+    };
+
+    void FrameArena::reset() {
+        used = 0;
+        frameBytes = 0;
+
+        if (!overflow && capacity >= reserved) { return; }
+
+        freeOverflow();
+
+        size_t target = peak > reserved ? peak : reserved;
+
+        if (target > capacity) {
+            freeBytes(resource, data, capacity);
+            data = allocBytes(resource, target);
+            capacity = target;
+        }
+    };
+
+    void FrameArena::reserve(size_t bytes) {
+        if (bytes > reserved) { reserved = bytes; }
+        if (!frameBytes) { reset(); }
+    };
+}
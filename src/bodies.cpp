@@ -1,6 +1,56 @@
 #include <ZETA/bodies.h>
+#include <cfloat>
 
 namespace Zeta {
+    // * ===============
+    // * Bounds
+    // * ===============
+
+    // Find the world space bounds of a collider. type is the collider's type as a RigidBodyCollider.
+    static inline void findBounds(int type, void const* collider, ZMath::Vec2D &min, ZMath::Vec2D &max) {
+        switch (type) {
+            case RIGID_CIRCLE_COLLIDER: {
+                Circle const* circle = (Circle const*) collider;
+
+                min = circle->c - circle->r;
+                max = circle->c + circle->r;
+
+                return;
+            }
+
+            case RIGID_AABB_COLLIDER: {
+                AABB const* aabb = (AABB const*) collider;
+
+                min = aabb->getMin();
+                max = aabb->getMax();
+
+                return;
+            }
+
+            case RIGID_BOX2D_COLLIDER: {
+                Box2D const* box = (Box2D const*) collider;
+
+                // ? The extent along each global axis is the sum of the projections of the Box2D's rotated halfsize.
+                ZMath::Vec2D h = ZMath::abs(box->rot) * box->getHalfsize();
+                min = box->pos - h;
+                max = box->pos + h;
+
+                return;
+            }
+        }
+
+        // * User defined colliders go here.
+
+        // bodies with an unknown shape are never culled
+        min = ZMath::Vec2D(-FLT_MAX, -FLT_MAX);
+        max = ZMath::Vec2D(FLT_MAX, FLT_MAX);
+    };
+
+    void RigidBody2D::updateBounds() { findBounds(colliderType, &collider, boundsMin, boundsMax); };
+    void StaticBody2D::updateBounds() { findBounds(colliderType, &collider, boundsMin, boundsMax); };
+    void KinematicBody2D::updateBounds() { findBounds(colliderType, &collider, boundsMin, boundsMax); };
+
+
     // * ===============
     // * RigidBody2D
     // * ===============
@@ -19,5 +69,7 @@ namespace Zeta {
         if      (colliderType == RIGID_CIRCLE_COLLIDER) { collider.circle.c = pos; }
         else if (colliderType == RIGID_AABB_COLLIDER)   { collider.aabb.pos = pos; }
         else if (colliderType == RIGID_BOX2D_COLLIDER)  { collider.box.pos = pos;  }
+
+        updateBounds();
     };
 }
@@ -0,0 +1,780 @@
+#include <ZETA/broadphase.h>
+#include <algorithm>
+#include <cfloat>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define ZETA_PACKET_SSE
+#endif
+
+namespace Zeta {
+    // * ======================
+    // * Bounding Boxes
+    // * ======================
+
+    void computeBounds(Circle const &circle, ZMath::Vec2D &min, ZMath::Vec2D &max) {
+        min = circle.c - circle.r;
+        max = circle.c + circle.r;
+    };
+
+    void computeBounds(AABB const &aabb, ZMath::Vec2D &min, ZMath::Vec2D &max) {
+        min = aabb.getMin();
+        max = aabb.getMax();
+    };
+
+    void computeBounds(Box2D const &box, ZMath::Vec2D &min, ZMath::Vec2D &max) {
+        // ? The extent along each global axis is the sum of the projections of the Box2D's rotated halfsize.
+
+        ZMath::Vec2D h = ZMath::abs(box.rot) * box.getHalfsize();
+        min = box.pos - h;
+        max = box.pos + h;
+    };
+
+    bool computeBounds(BodyRef const &ref, ZMath::Vec2D &min, ZMath::Vec2D &max) {
+        int type;
+        getCollider(ref, type);
+
+        // * User defined colliders go here.
+        if (type != RIGID_CIRCLE_COLLIDER && type != RIGID_AABB_COLLIDER && type != RIGID_BOX2D_COLLIDER) { return 0; }
+
+        // ? Bodies cache the bounds of their collider, so building a tree never has to look at the colliders themselves.
+        switch (ref.type) {
+            case RIGID_BODY: {
+                RigidBody2D const* rb = (RigidBody2D const*) ref.body;
+                min = rb->boundsMin;
+                max = rb->boundsMax;
+                return 1;
+            }
+
+            case STATIC_BODY: {
+                StaticBody2D const* sb = (StaticBody2D const*) ref.body;
+                min = sb->boundsMin;
+                max = sb->boundsMax;
+                return 1;
+            }
+
+            case KINEMATIC_BODY: {
+                KinematicBody2D const* kb = (KinematicBody2D const*) ref.body;
+                min = kb->boundsMin;
+                max = kb->boundsMax;
+                return 1;
+            }
+        }
+
+        return 0;
+    };
+
+
+    // * ======================================
+    // * Bounding Volume Hierarchy (BVH)
+    // * ======================================
+
+    BVH::~BVH() {
+        freeArray(resource, nodes, 2*capacity);
+        freeArray(resource, items, capacity);
+    };
+
+    void BVH::reserve(int n) {
+        if (n <= capacity) { return; }
+
+        int oldCapacity = capacity;
+
+        if (!capacity) { capacity = BVH_LEAF_SIZE; }
+        while (capacity < n) { capacity *= 2; }
+
+        BVHItem* temp = allocArray<BVHItem>(resource, capacity);
+        for (int i = 0; i < itemCount; ++i) { temp[i] = items[i]; }
+
+        freeArray(resource, items, oldCapacity);
+        items = temp;
+
+        // ? A binary tree with at most BVH_LEAF_SIZE items per leaf never needs more than 2n - 1 nodes.
+        // ? The nodes are rebuilt from scratch so there is nothing to copy.
+
+        freeArray(resource, nodes, 2*oldCapacity);
+        nodes = allocArray<BVHNode>(resource, 2*capacity);
+        nodeCount = 0;
+    };
+
+    void BVH::add(BodyRef const &ref) {
+        BVHItem &item = items[itemCount];
+        if (!computeBounds(ref, item.min, item.max)) { return; }
+
+        item.ref = ref;
+        item.index = itemCount++;
+    };
+
+    // Partition items so nth holds the item that would be there if [first, last) were sorted.
+    template <typename Compare>
+    static inline void splitItems(BVHItem* first, BVHItem* nth, BVHItem* last, Compare comp) {
+#ifdef ZETA_DETERMINISTIC
+        // ? nth_element leaves the items on either side in an order that depends on the standard library.
+        // ? Sorting with the order the items were added in as a tie-breaker has only one possible result, so the tree is the
+        // ?  same on every platform. stable_sort would too, but it allocates a buffer, which fixed memory modes cannot allow.
+        std::sort(first, last, [&comp](BVHItem const &a, BVHItem const &b) { return comp(a, b) || (!comp(b, a) && a.index < b.index); });
+#else
+        std::nth_element(first, nth, last, comp);
+#endif
+    };
+
+    // Recursively build the subtree for items [start, start + count) into nodes[index].
+    static void buildNode(BVH &tree, int index, int start, int count) {
+        BVHNode &node = tree.nodes[index];
+        BVHItem* items = tree.items;
+
+        // bounds of the items and of their centers
+        node.min = items[start].min;
+        node.max = items[start].max;
+        ZMath::Vec2D cMin = (items[start].min + items[start].max) * 0.5f, cMax = cMin;
+
+        for (int i = start + 1; i < start + count; ++i) {
+            node.min.set(MIN(node.min.x, items[i].min.x), MIN(node.min.y, items[i].min.y));
+            node.max.set(MAX(node.max.x, items[i].max.x), MAX(node.max.y, items[i].max.y));
+
+            ZMath::Vec2D c = (items[i].min + items[i].max) * 0.5f;
+            cMin.set(MIN(cMin.x, c.x), MIN(cMin.y, c.y));
+            cMax.set(MAX(cMax.x, c.x), MAX(cMax.y, c.y));
+        }
+
+        if (count <= BVH_LEAF_SIZE) {
+            node.left = start;
+            node.count = count;
+            return;
+        }
+
+        // * Split at the median along the axis the centers are most spread out on.
+
+        int mid = start + count/2;
+
+        if (cMax.x - cMin.x >= cMax.y - cMin.y) {
+            splitItems(items + start, items + mid, items + start + count,
+                       [](BVHItem const &a, BVHItem const &b) { return a.min.x + a.max.x < b.min.x + b.max.x; });
+
+        } else {
+            splitItems(items + start, items + mid, items + start + count,
+                       [](BVHItem const &a, BVHItem const &b) { return a.min.y + a.max.y < b.min.y + b.max.y; });
+        }
+
+        int left = tree.nodeCount;
+        tree.nodeCount += 2;
+
+        node.left = left;
+        node.count = 0;
+
+        buildNode(tree, left, start, mid - start);
+        buildNode(tree, left + 1, mid, start + count - mid);
+    };
+
+    // Perimeter of a box. Used as the cost of a node since it is proportional to the chance a random query hits it.
+    static inline float perimeter(ZMath::Vec2D const &min, ZMath::Vec2D const &max) { return 2.0f*((max.x - min.x) + (max.y - min.y)); };
+
+    void BVH::build() {
+        buildCost = 0.0f;
+
+        if (!itemCount) {
+            nodeCount = 0;
+            return;
+        }
+
+        nodeCount = 1;
+        buildNode(*this, 0, 0, itemCount);
+
+        for (int i = 0; i < nodeCount; ++i) { buildCost += perimeter(nodes[i].min, nodes[i].max); }
+    };
+
+    float BVH::refit() {
+        for (int i = 0; i < itemCount; ++i) { computeBounds(items[i].ref, items[i].min, items[i].max); }
+
+        // ? Children are always stored after their parent, so walking the nodes backwards finishes every child before its parent.
+        float cost = 0.0f;
+
+        for (int i = nodeCount - 1; i >= 0; --i) {
+            BVHNode &node = nodes[i];
+
+            if (node.count) {
+                node.min = items[node.left].min;
+                node.max = items[node.left].max;
+
+                for (int j = node.left + 1; j < node.left + node.count; ++j) {
+                    node.min.set(MIN(node.min.x, items[j].min.x), MIN(node.min.y, items[j].min.y));
+                    node.max.set(MAX(node.max.x, items[j].max.x), MAX(node.max.y, items[j].max.y));
+                }
+
+            } else {
+                BVHNode const &left = nodes[node.left];
+                BVHNode const &right = nodes[node.left + 1];
+
+                node.min.set(MIN(left.min.x, right.min.x), MIN(left.min.y, right.min.y));
+                node.max.set(MAX(left.max.x, right.max.x), MAX(left.max.y, right.max.y));
+            }
+
+            cost += perimeter(node.min, node.max);
+        }
+
+        return cost;
+    };
+
+
+    // * ======================
+    // * Raycasting
+    // * ======================
+
+    bool raycast(BodyRef const &ref, Ray2D const &ray, float &dist, ZMath::Vec2D &normal) {
+        int type;
+        void const* collider = getCollider(ref, type);
+
+        switch (type) {
+            case RIGID_CIRCLE_COLLIDER: { return raycast(*((Circle const*) collider), ray, dist, normal); }
+            case RIGID_AABB_COLLIDER: { return raycast(*((AABB const*) collider), ray, dist, normal); }
+            case RIGID_BOX2D_COLLIDER: { return raycast(*((Box2D const*) collider), ray, dist, normal); }
+        }
+
+        // * User defined colliders go here.
+
+        dist = -1.0f;
+        return 0;
+    };
+
+    // Distance along the ray at which it enters a bounding box. Returns FLT_MAX if it misses.
+    // invDir is 1/ray.dir with zero components replaced by FLT_MAX to avoid NaNs.
+    static inline float rayEntry(ZMath::Vec2D const &min, ZMath::Vec2D const &max, ZMath::Vec2D const &origin, ZMath::Vec2D const &invDir) {
+        float t1 = (min.x - origin.x)*invDir.x, t2 = (max.x - origin.x)*invDir.x;
+        float t3 = (min.y - origin.y)*invDir.y, t4 = (max.y - origin.y)*invDir.y;
+
+        float tMin = MAX(MIN(t1, t2), MIN(t3, t4));
+        float tMax = MIN(MAX(t1, t2), MAX(t3, t4));
+
+        if (tMax < 0.0f || tMax < tMin) { return FLT_MAX; }
+        return MAX(tMin, 0.0f);
+    };
+
+    static inline ZMath::Vec2D safeInverse(ZMath::Vec2D const &dir) {
+        return ZMath::Vec2D(dir.x ? 1.0f/dir.x : FLT_MAX, dir.y ? 1.0f/dir.y : FLT_MAX);
+    };
+
+    bool raycast(BVH const &tree, Ray2D const &ray, float maxDist, RaycastHit &hit, bool any) {
+        if (!tree.nodeCount) { return 0; }
+
+        // ? Visit the closer child first and skip any node the ray enters past the best hit so far.
+        // ? Each stack entry stores the entry distance computed when it was pushed so it can be culled
+        // ?  again after the best hit shrinks.
+
+        ZMath::Vec2D invDir = safeInverse(ray.dir);
+        float best = maxDist;
+        bool found = 0;
+
+        int stack[BVH_STACK_SIZE];
+        float entries[BVH_STACK_SIZE];
+        int top = 0;
+
+        float t = rayEntry(tree.nodes[0].min, tree.nodes[0].max, ray.origin, invDir);
+        if (t > best) { return 0; }
+
+        stack[top] = 0;
+        entries[top++] = t;
+
+        while (top) {
+            --top;
+            if (entries[top] > best) { continue; }
+
+            BVHNode const &node = tree.nodes[stack[top]];
+
+            if (node.count) {
+                for (int i = node.left; i < node.left + node.count; ++i) {
+                    BVHItem const &item = tree.items[i];
+                    if (isSensor(item.ref) || rayEntry(item.min, item.max, ray.origin, invDir) > best) { continue; }
+
+                    float dist;
+                    ZMath::Vec2D normal;
+
+                    if (raycast(item.ref, ray, dist, normal) && dist <= best) {
+                        best = dist;
+                        found = 1;
+
+                        hit.body = item.ref;
+                        hit.dist = dist;
+                        hit.normal = normal;
+                        hit.point = ray.origin + ray.dir * dist;
+
+                        if (any) { return 1; }
+                    }
+                }
+
+                continue;
+            }
+
+            BVHNode const &left = tree.nodes[node.left];
+            BVHNode const &right = tree.nodes[node.left + 1];
+
+            float tL = rayEntry(left.min, left.max, ray.origin, invDir);
+            float tR = rayEntry(right.min, right.max, ray.origin, invDir);
+
+            // push the farther child first so the closer one is popped first
+            if (tL <= tR) {
+                if (tR <= best) { stack[top] = node.left + 1; entries[top++] = tR; }
+                if (tL <= best) { stack[top] = node.left; entries[top++] = tL; }
+
+            } else {
+                if (tL <= best) { stack[top] = node.left; entries[top++] = tL; }
+                if (tR <= best) { stack[top] = node.left + 1; entries[top++] = tR; }
+            }
+        }
+
+        return found;
+    };
+
+    int raycastAll(BVH const &tree, Ray2D const &ray, float maxDist, RaycastHit* hits, int count, int capacity) {
+        if (!tree.nodeCount || capacity <= 0) { return count; }
+
+        ZMath::Vec2D invDir = safeInverse(ray.dir);
+
+        // once hits is full, only hits closer than the farthest stored hit matter
+        float limit = count == capacity ? MIN(maxDist, hits[count - 1].dist) : maxDist;
+
+        int stack[BVH_STACK_SIZE];
+        int top = 0;
+
+        stack[top++] = 0;
+
+        while (top) {
+            BVHNode const &node = tree.nodes[stack[--top]];
+            if (rayEntry(node.min, node.max, ray.origin, invDir) > limit) { continue; }
+
+            if (!node.count) {
+                stack[top++] = node.left;
+                stack[top++] = node.left + 1;
+                continue;
+            }
+
+            for (int i = node.left; i < node.left + node.count; ++i) {
+                BVHItem const &item = tree.items[i];
+                if (isSensor(item.ref)) { continue; }
+
+                float dist;
+                ZMath::Vec2D normal;
+
+                if (!raycast(item.ref, ray, dist, normal) || dist > limit) { continue; }
+
+                // insertion sort the new hit into place, dropping the farthest hit if hits is full
+                int j = count < capacity ? count++ : count - 1;
+                while (j > 0 && hits[j - 1].dist > dist) {
+                    hits[j] = hits[j - 1];
+                    --j;
+                }
+
+                hits[j].body = item.ref;
+                hits[j].dist = dist;
+                hits[j].normal = normal;
+                hits[j].point = ray.origin + ray.dir * dist;
+
+                if (count == capacity) { limit = MIN(maxDist, hits[count - 1].dist); }
+            }
+        }
+
+        return count;
+    };
+
+    // * ==========================
+    // * Packet Raycasting
+    // * ==========================
+
+    // Rays of a packet stored as a structure of arrays so all of the rays can be tested against a box at once.
+    struct RayPacket {
+        alignas(16) float ox[RAY_PACKET_SIZE], oy[RAY_PACKET_SIZE]; // origins
+        alignas(16) float ix[RAY_PACKET_SIZE], iy[RAY_PACKET_SIZE]; // inverse directions
+        alignas(16) float best[RAY_PACKET_SIZE]; // best distance found so far. -1 for unused lanes so they never pass.
+    };
+
+    // Slab test a bounding box against every ray in the packet.
+    // Returns a bitmask of the rays entering the box no farther than their best hit and sets tNear to the closest of those entry distances.
+    static inline int packetEntry(RayPacket const &p, ZMath::Vec2D const &min, ZMath::Vec2D const &max, float &tNear) {
+#ifdef ZETA_PACKET_SSE
+        __m128 ox = _mm_load_ps(p.ox), oy = _mm_load_ps(p.oy);
+        __m128 ix = _mm_load_ps(p.ix), iy = _mm_load_ps(p.iy);
+
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.x), ox), ix);
+        __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.x), ox), ix);
+        __m128 t3 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min.y), oy), iy);
+        __m128 t4 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max.y), oy), iy);
+
+        __m128 tMin = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1, t2), _mm_min_ps(t3, t4)), _mm_setzero_ps());
+        __m128 tMax = _mm_min_ps(_mm_max_ps(t1, t2), _mm_max_ps(t3, t4));
+
+        __m128 pass = _mm_and_ps(_mm_cmple_ps(tMin, tMax), _mm_cmple_ps(tMin, _mm_load_ps(p.best)));
+        int mask = _mm_movemask_ps(pass);
+
+        if (mask) {
+            // horizontal min of the entry distances of the rays that passed
+            __m128 t = _mm_or_ps(_mm_and_ps(pass, tMin), _mm_andnot_ps(pass, _mm_set1_ps(FLT_MAX)));
+            t = _mm_min_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+            t = _mm_min_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+            tNear = _mm_cvtss_f32(t);
+        }
+
+        return mask;
+#else
+        int mask = 0;
+        tNear = FLT_MAX;
+
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i) {
+            float t1 = (min.x - p.ox[i])*p.ix[i], t2 = (max.x - p.ox[i])*p.ix[i];
+            float t3 = (min.y - p.oy[i])*p.iy[i], t4 = (max.y - p.oy[i])*p.iy[i];
+
+            float tMin = MAX(MAX(MIN(t1, t2), MIN(t3, t4)), 0.0f);
+            float tMax = MIN(MAX(t1, t2), MAX(t3, t4));
+
+            if (tMin <= tMax && tMin <= p.best[i]) {
+                mask |= 1 << i;
+                if (tMin < tNear) { tNear = tMin; }
+            }
+        }
+
+        return mask;
+#endif
+    };
+
+    void raycastPacket(BVH const &tree, Ray2D const* rays, int count, float* best, RaycastHit* hits) {
+        if (!tree.nodeCount) { return; }
+
+        RayPacket p;
+
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i) {
+            if (i < count) {
+                ZMath::Vec2D invDir = safeInverse(rays[i].dir);
+
+                p.ox[i] = rays[i].origin.x;
+                p.oy[i] = rays[i].origin.y;
+                p.ix[i] = invDir.x;
+                p.iy[i] = invDir.y;
+                p.best[i] = best[i];
+
+            } else {
+                p.ox[i] = p.oy[i] = p.ix[i] = p.iy[i] = 0.0f;
+                p.best[i] = -1.0f;
+            }
+        }
+
+        // ? Same traversal as the single ray version except a node is only skipped once every ray in the packet can skip it.
+        // ? Nodes are re-tested when popped since the best distances may have shrunk since they were pushed.
+
+        int stack[BVH_STACK_SIZE];
+        int top = 0;
+        float tNear;
+
+        stack[top++] = 0;
+
+        while (top) {
+            BVHNode const &node = tree.nodes[stack[--top]];
+            if (!packetEntry(p, node.min, node.max, tNear)) { continue; }
+
+            if (node.count) {
+                for (int i = node.left; i < node.left + node.count; ++i) {
+                    BVHItem const &item = tree.items[i];
+                    if (isSensor(item.ref)) { continue; }
+
+                    int mask = packetEntry(p, item.min, item.max, tNear);
+
+                    // only the rays that reach the item's bounds need the exact test
+                    for (int j = 0; mask; ++j, mask >>= 1) {
+                        if (!(mask & 1)) { continue; }
+
+                        float dist;
+                        ZMath::Vec2D normal;
+
+                        if (raycast(item.ref, rays[j], dist, normal) && dist <= p.best[j]) {
+                            p.best[j] = dist;
+
+                            hits[j].body = item.ref;
+                            hits[j].dist = dist;
+                            hits[j].normal = normal;
+                            hits[j].point = rays[j].origin + rays[j].dir * dist;
+                        }
+                    }
+                }
+
+                continue;
+            }
+
+            float tL, tR;
+            int maskL = packetEntry(p, tree.nodes[node.left].min, tree.nodes[node.left].max, tL);
+            int maskR = packetEntry(p, tree.nodes[node.left + 1].min, tree.nodes[node.left + 1].max, tR);
+
+            // push the farther child first so the closer one is popped first
+            if (maskL && maskR) {
+                if (tL <= tR) {
+                    stack[top++] = node.left + 1;
+                    stack[top++] = node.left;
+
+                } else {
+                    stack[top++] = node.left;
+                    stack[top++] = node.left + 1;
+                }
+
+            } else if (maskL) { stack[top++] = node.left; }
+            else if (maskR) { stack[top++] = node.left + 1; }
+        }
+
+        for (int i = 0; i < count; ++i) { best[i] = p.best[i]; }
+    };
+
+
+    // * ======================
+    // * Region Queries
+    // * ======================
+
+    int query(BVH const &tree, int type, void const* region, BodyRef* bodies, int count, int capacity) {
+        if (!tree.nodeCount || count >= capacity) { return count; }
+
+        ZMath::Vec2D min, max;
+
+        switch (type) {
+            case RIGID_CIRCLE_COLLIDER: { computeBounds(*((Circle const*) region), min, max); break; }
+            case RIGID_AABB_COLLIDER: { computeBounds(*((AABB const*) region), min, max); break; }
+            case RIGID_BOX2D_COLLIDER: { computeBounds(*((Box2D const*) region), min, max); break; }
+            default: { return count; }
+        }
+
+        int stack[BVH_STACK_SIZE];
+        int top = 0;
+
+        stack[top++] = 0;
+
+        while (top) {
+            BVHNode const &node = tree.nodes[stack[--top]];
+
+            if (node.min.x > max.x || node.max.x < min.x || node.min.y > max.y || node.max.y < min.y) { continue; }
+
+            if (!node.count) {
+                stack[top++] = node.left;
+                stack[top++] = node.left + 1;
+                continue;
+            }
+
+            for (int i = node.left; i < node.left + node.count; ++i) {
+                BVHItem const &item = tree.items[i];
+
+                if (item.min.x > max.x || item.max.x < min.x || item.min.y > max.y || item.max.y < min.y) { continue; }
+                if (!BodyAndCollider(item.ref, type, region)) { continue; }
+
+                bodies[count++] = item.ref;
+                if (count == capacity) { return count; }
+            }
+        }
+
+        return count;
+    };
+
+
+    // * ======================
+    // * Shape Casting
+    // * ======================
+
+    // Distance the time of impact is refined to.
+    static const float SHAPECAST_TOLERANCE = 0.0001f;
+
+    // Max number of bisection steps used to refine the time of impact.
+    static const int SHAPECAST_ITERATIONS = 24;
+
+    // Max number of advancement steps taken across the stretch of a sweep where the bounds overlap.
+    static const int SHAPECAST_MAX_STEPS = 256;
+
+    // Half of the thinnest dimension of a primitive. Moving a shape by less than this cannot skip over it.
+    static inline float minExtent(int type, void const* collider) {
+        switch (type) {
+            case RIGID_CIRCLE_COLLIDER: { return ((Circle const*) collider)->r; }
+
+            case RIGID_AABB_COLLIDER: {
+                ZMath::Vec2D halfsize = ((AABB const*) collider)->getHalfsize();
+                return MIN(halfsize.x, halfsize.y);
+            }
+
+            case RIGID_BOX2D_COLLIDER: {
+                ZMath::Vec2D halfsize = ((Box2D const*) collider)->getHalfsize();
+                return MIN(halfsize.x, halfsize.y);
+            }
+        }
+
+        return 0.0f;
+    };
+
+    static inline bool shapeBounds(int type, void const* shape, ZMath::Vec2D &min, ZMath::Vec2D &max) {
+        switch (type) {
+            case RIGID_CIRCLE_COLLIDER: { computeBounds(*((Circle const*) shape), min, max); return 1; }
+            case RIGID_AABB_COLLIDER: { computeBounds(*((AABB const*) shape), min, max); return 1; }
+            case RIGID_BOX2D_COLLIDER: { computeBounds(*((Box2D const*) shape), min, max); return 1; }
+        }
+
+        return 0;
+    };
+
+    // Determine if a primitive moved by offset overlaps a body. Sets normal if it is not nullptr.
+    static bool overlapsAt(BodyRef const &ref, int type, void const* shape, ZMath::Vec2D const &offset, ZMath::Vec2D* normal = nullptr) {
+        switch (type) {
+            case RIGID_CIRCLE_COLLIDER: {
+                Circle moved = *((Circle const*) shape);
+                moved.c += offset;
+                return normal ? BodyAndCollider(ref, type, &moved, *normal) : BodyAndCollider(ref, type, &moved);
+            }
+
+            case RIGID_AABB_COLLIDER: {
+                AABB moved = *((AABB const*) shape);
+                moved.pos += offset;
+                return normal ? BodyAndCollider(ref, type, &moved, *normal) : BodyAndCollider(ref, type, &moved);
+            }
+
+            case RIGID_BOX2D_COLLIDER: {
+                Box2D moved = *((Box2D const*) shape);
+                moved.pos += offset;
+                return normal ? BodyAndCollider(ref, type, &moved, *normal) : BodyAndCollider(ref, type, &moved);
+            }
+        }
+
+        return 0;
+    };
+
+    // Find the distances along a ray where it enters and exits a bounding box.
+    static inline bool rayInterval(ZMath::Vec2D const &min, ZMath::Vec2D const &max, ZMath::Vec2D const &origin, ZMath::Vec2D const &invDir,
+                                   float &tMin, float &tMax) {
+
+        float t1 = (min.x - origin.x)*invDir.x, t2 = (max.x - origin.x)*invDir.x;
+        float t3 = (min.y - origin.y)*invDir.y, t4 = (max.y - origin.y)*invDir.y;
+
+        tMin = MAX(MAX(MIN(t1, t2), MIN(t3, t4)), 0.0f);
+        tMax = MIN(MAX(t1, t2), MAX(t3, t4));
+
+        return tMin <= tMax;
+    };
+
+    bool shapecast(BodyRef const &ref, int type, void const* shape, ZMath::Vec2D const &dir, float maxDist, float &dist, ZMath::Vec2D &normal, bool exact) {
+        int bodyType;
+        void const* collider = getCollider(ref, bodyType);
+
+        ZMath::Vec2D min, max, bodyMin, bodyMax;
+        if (!collider || !shapeBounds(type, shape, min, max) || !computeBounds(ref, bodyMin, bodyMax)) { return 0; }
+
+        // ? Only the stretch of the sweep where the bounding boxes overlap can contain the time of impact.
+        // ? We find it by sweeping the center of the shape's bounds against the body's bounds grown by the shape's half extents.
+
+        ZMath::Vec2D halfsize = (max - min) * 0.5f;
+        ZMath::Vec2D center = (min + max) * 0.5f;
+
+        float t0, t1;
+        if (!rayInterval(bodyMin - halfsize, bodyMax + halfsize, center, safeInverse(dir), t0, t1) || t0 > maxDist) { return 0; }
+        t1 = MIN(t1, maxDist);
+
+        // ? Conservative advancement: neither shape can be skipped over by a step shorter than half their thinnest dimension.
+        // ? Once a step ends overlapping, bisect between it and the last clear position to find the time of impact.
+
+        // ? A degenerate shape (a zero radius circle or a flat box) would step by SHAPECAST_TOLERANCE and take up to
+        // ?  (t1 - t0)/SHAPECAST_TOLERANCE steps, so the number of steps is capped. The relative motion is the same whichever
+        // ?  shape moves, so a capped step can only skip a body when the shape and the body are both thinner than it.
+        // ? Exact sweeps are never capped. They only cost more when the sweep is long compared to the thinner shape.
+
+        float step = MAX(MIN(minExtent(type, shape), minExtent(bodyType, collider)), SHAPECAST_TOLERANCE);
+        if (!exact) { step = MAX(step, (t1 - t0)/SHAPECAST_MAX_STEPS); }
+
+        // ? A shape that starts out touching the body but is moving away from it does not hit it.
+        // ? Otherwise anything resting against a surface could never be swept away from it.
+
+        float lo = t0;
+        if (overlapsAt(ref, type, shape, dir * lo, &normal)) {
+            if (lo == 0.0f && normal * dir > 0.0f) { return 0; }
+
+            dist = lo;
+            return 1;
+        }
+
+        while (lo < t1) {
+            float hi = MIN(lo + step, t1);
+
+            if (overlapsAt(ref, type, shape, dir * hi)) {
+                for (int i = 0; i < SHAPECAST_ITERATIONS && hi - lo > SHAPECAST_TOLERANCE; ++i) {
+                    float mid = (lo + hi) * 0.5f;
+
+                    if (overlapsAt(ref, type, shape, dir * mid)) { hi = mid; }
+                    else { lo = mid; }
+                }
+
+                // report the last clear distance so moving the shape by it never leaves it overlapping
+                overlapsAt(ref, type, shape, dir * hi, &normal);
+                dist = lo;
+                return 1;
+            }
+
+            lo = hi;
+        }
+
+        return 0;
+    };
+
+    bool shapecast(BVH const &tree, int type, void const* shape, ZMath::Vec2D const &dir, float maxDist, ShapecastHit &hit, void const* ignore, bool exact) {
+        ZMath::Vec2D min, max;
+        if (!tree.nodeCount || !shapeBounds(type, shape, min, max)) { return 0; }
+
+        // ? Same traversal as the raycast except every bounding box is grown by the half extents of the swept shape.
+
+        ZMath::Vec2D halfsize = (max - min) * 0.5f;
+        ZMath::Vec2D center = (min + max) * 0.5f;
+        ZMath::Vec2D invDir = safeInverse(dir);
+
+        float best = maxDist;
+        bool found = 0;
+
+        int stack[BVH_STACK_SIZE];
+        float entries[BVH_STACK_SIZE];
+        int top = 0;
+
+        float t = rayEntry(tree.nodes[0].min - halfsize, tree.nodes[0].max + halfsize, center, invDir);
+        if (t > best) { return 0; }
+
+        stack[top] = 0;
+        entries[top++] = t;
+
+        while (top) {
+            --top;
+            if (entries[top] > best) { continue; }
+
+            BVHNode const &node = tree.nodes[stack[top]];
+
+            if (node.count) {
+                for (int i = node.left; i < node.left + node.count; ++i) {
+                    BVHItem const &item = tree.items[i];
+                    if (item.ref.body == ignore || isSensor(item.ref)) { continue; }
+                    if (rayEntry(item.min - halfsize, item.max + halfsize, center, invDir) > best) { continue; }
+
+                    float dist;
+                    ZMath::Vec2D normal;
+
+                    if (shapecast(item.ref, type, shape, dir, best, dist, normal, exact) && dist <= best) {
+                        best = dist;
+                        found = 1;
+
+                        hit.body = item.ref;
+                        hit.dist = dist;
+                        hit.normal = normal;
+                    }
+                }
+
+                continue;
+            }
+
+            BVHNode const &left = tree.nodes[node.left];
+            BVHNode const &right = tree.nodes[node.left + 1];
+
+            float tL = rayEntry(left.min - halfsize, left.max + halfsize, center, invDir);
+            float tR = rayEntry(right.min - halfsize, right.max + halfsize, center, invDir);
+
+            // push the farther child first so the closer one is popped first
+            if (tL <= tR) {
+                if (tR <= best) { stack[top] = node.left + 1; entries[top++] = tR; }
+                if (tL <= best) { stack[top] = node.left; entries[top++] = tL; }
+
+            } else {
+                if (tL <= best) { stack[top] = node.left; entries[top++] = tL; }
+                if (tR <= best) { stack[top] = node.left + 1; entries[top++] = tR; }
+            }
+        }
+
+        return found;
+    };
+}
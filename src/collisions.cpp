@@ -1,11 +1,17 @@
 #include <ZETA/collisions.h>
 
 namespace Zeta {
+    // Allocate the contact points of a manifold from the arena if there is one.
+    static inline ZMath::Vec2D* allocContactPoints(int n, FrameArena* arena) {
+        return arena ? arena->alloc<ZMath::Vec2D>(n) : new ZMath::Vec2D[n];
+    };
+
+
     // * ===================================
     // * Collision Manifold Calculators
     // * ===================================
 
-    CollisionManifold findCollisionFeatures(Circle const &circle1, Circle const &circle2) {
+    CollisionManifold findCollisionFeatures(Circle const &circle1, Circle const &circle2, FrameArena* arena) {
         CollisionManifold result;
 
         float r = circle1.r + circle2.r;
@@ -22,13 +28,13 @@ namespace Zeta {
 
         // determine the contact point
         result.numPoints = 1;
-        result.contactPoints = new ZMath::Vec2D[result.numPoints];
+        result.contactPoints = allocContactPoints(result.numPoints, arena);
         result.contactPoints[0] = circle1.c + (result.normal * (circle1.r - result.pDist));
 
         return result;
     };
 
-    CollisionManifold findCollisionFeatures(Circle const &circle, AABB const &aabb) {
+    CollisionManifold findCollisionFeatures(Circle const &circle, AABB const &aabb, FrameArena* arena) {
         CollisionManifold result;
 
         // ? We know a circle and AABB would intersect if the distance from the closest point to the center on the AABB
@@ -48,7 +54,7 @@ namespace Zeta {
         // Therefore, we just set our contact point to closest.
 
         result.numPoints = 1;
-        result.contactPoints = new ZMath::Vec2D[1];
+        result.contactPoints = allocContactPoints(1, arena);
         result.contactPoints[0] = closest;
 
         // determine the penetration distance and collision normal
@@ -61,7 +67,7 @@ namespace Zeta {
         return result;
     };
 
-    CollisionManifold findCollisionFeatures(Circle const &circle, Box2D const &box) {
+    CollisionManifold findCollisionFeatures(Circle const &circle, Box2D const &box, FrameArena* arena) {
         CollisionManifold result;
 
         ZMath::Vec2D closest = circle.c - box.pos;
@@ -82,7 +88,7 @@ namespace Zeta {
         closest = box.rot.transpose() * closest + box.pos;
 
         result.numPoints = 1;
-        result.contactPoints = new ZMath::Vec2D[1];
+        result.contactPoints = allocContactPoints(1, arena);
         result.contactPoints[0] = closest;
 
         // determine the penetration distance and the collision normal
@@ -209,7 +215,7 @@ namespace Zeta {
 
     // ? Normal points towards B and away from A
 
-    CollisionManifold findCollisionFeatures(AABB const &aabb1, AABB const &aabb2) {
+    CollisionManifold findCollisionFeatures(AABB const &aabb1, AABB const &aabb2, FrameArena* arena) {
         CollisionManifold result;
 
         // half size of AABB a and b respectively
@@ -329,7 +335,7 @@ namespace Zeta {
         result.pDist = -result.pDist;
         result.hit = 1;
         result.numPoints = np;
-        result.contactPoints = new ZMath::Vec2D[np];
+        result.contactPoints = allocContactPoints(np, arena);
 
         for (int i = 0; i < np; ++i) { result.contactPoints[i] = contactPoints[i]; }
         
@@ -338,7 +344,7 @@ namespace Zeta {
 
     // ? Normal points towards B and away from A
 
-    CollisionManifold findCollisionFeatures(AABB const &aabb, Box2D const &box) {
+    CollisionManifold findCollisionFeatures(AABB const &aabb, Box2D const &box, FrameArena* arena) {
         CollisionManifold result;
 
         // half size of a and b respectively
@@ -504,7 +510,7 @@ namespace Zeta {
         result.pDist = -result.pDist;
         result.hit = 1;
         result.numPoints = np;
-        result.contactPoints = new ZMath::Vec2D[np];
+        result.contactPoints = allocContactPoints(np, arena);
 
         for (int i = 0; i < np; ++i) { result.contactPoints[i] = contactPoints[i]; }
         
@@ -513,7 +519,7 @@ namespace Zeta {
 
     // ? Normal points towards B and away from A
 
-    CollisionManifold findCollisionFeatures(Box2D const &box1, Box2D const &box2) {
+    CollisionManifold findCollisionFeatures(Box2D const &box1, Box2D const &box2, FrameArena* arena) {
         CollisionManifold result;
 
         // half size of Box2D a and b respectively
@@ -694,7 +700,7 @@ namespace Zeta {
         result.pDist = -result.pDist;
         result.hit = 1;
         result.numPoints = np;
-        result.contactPoints = new ZMath::Vec2D[np];
+        result.contactPoints = allocContactPoints(np, arena);
 
         for (int i = 0; i < np; ++i) { result.contactPoints[i] = contactPoints[i]; }
         
@@ -703,43 +709,43 @@ namespace Zeta {
 
     // Find the collision features and resolve the impulse between two arbitrary primitives.
     // The normal will point towards B and away from A.
-    CollisionManifold findCollisionFeatures(RigidBody2D* rb1, RigidBody2D* rb2) {
+    CollisionManifold findCollisionFeatures(RigidBody2D* rb1, RigidBody2D* rb2, FrameArena* arena) {
         switch (rb1->colliderType) {
             case RIGID_CIRCLE_COLLIDER: {
-                if (rb2->colliderType == RIGID_CIRCLE_COLLIDER) { return findCollisionFeatures(rb1->collider.circle, rb2->collider.circle); }
-                if (rb2->colliderType == RIGID_AABB_COLLIDER) { return findCollisionFeatures(rb1->collider.circle, rb2->collider.aabb); }
-                if (rb2->colliderType == RIGID_BOX2D_COLLIDER) { return findCollisionFeatures(rb1->collider.circle, rb2->collider.box); }
+                if (rb2->colliderType == RIGID_CIRCLE_COLLIDER) { return findCollisionFeatures(rb1->collider.circle, rb2->collider.circle, arena); }
+                if (rb2->colliderType == RIGID_AABB_COLLIDER) { return findCollisionFeatures(rb1->collider.circle, rb2->collider.aabb, arena); }
+                if (rb2->colliderType == RIGID_BOX2D_COLLIDER) { return findCollisionFeatures(rb1->collider.circle, rb2->collider.box, arena); }
 
                 break;
             }
 
             case RIGID_AABB_COLLIDER: {
                 if (rb2->colliderType == RIGID_CIRCLE_COLLIDER) {
-                    CollisionManifold manifold = findCollisionFeatures(rb2->collider.circle, rb1->collider.aabb);
+                    CollisionManifold manifold = findCollisionFeatures(rb2->collider.circle, rb1->collider.aabb, arena);
                     manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                     return manifold;
                 }
 
-                if (rb2->colliderType == RIGID_AABB_COLLIDER) { return findCollisionFeatures(rb1->collider.aabb, rb2->collider.aabb); }
-                if (rb2->colliderType == RIGID_BOX2D_COLLIDER) { return findCollisionFeatures(rb1->collider.aabb, rb2->collider.box); }
+                if (rb2->colliderType == RIGID_AABB_COLLIDER) { return findCollisionFeatures(rb1->collider.aabb, rb2->collider.aabb, arena); }
+                if (rb2->colliderType == RIGID_BOX2D_COLLIDER) { return findCollisionFeatures(rb1->collider.aabb, rb2->collider.box, arena); }
 
                 break;
             }
 
             case RIGID_BOX2D_COLLIDER: {
                 if (rb2->colliderType == RIGID_CIRCLE_COLLIDER) {
-                    CollisionManifold manifold = findCollisionFeatures(rb2->collider.circle, rb1->collider.box);
+                    CollisionManifold manifold = findCollisionFeatures(rb2->collider.circle, rb1->collider.box, arena);
                     manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                     return manifold;
                 }
 
                 if (rb2->colliderType == RIGID_AABB_COLLIDER) {
-                    CollisionManifold manifold = findCollisionFeatures(rb2->collider.aabb, rb1->collider.box);
+                    CollisionManifold manifold = findCollisionFeatures(rb2->collider.aabb, rb1->collider.box, arena);
                     manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                     return manifold;
                 }
 
-                if (rb2->colliderType == RIGID_BOX2D_COLLIDER) { return findCollisionFeatures(rb1->collider.box, rb2->collider.box); }
+                if (rb2->colliderType == RIGID_BOX2D_COLLIDER) { return findCollisionFeatures(rb1->collider.box, rb2->collider.box, arena); }
 
                 break;
             }
@@ -755,46 +761,46 @@ namespace Zeta {
 
     // Find the collision features between a rigid and static body.
     // The normal will point away from the static body and towards the rigid body.
-    CollisionManifold findCollisionFeatures(RigidBody2D* rb, StaticBody2D* sb) {
+    CollisionManifold findCollisionFeatures(RigidBody2D* rb, StaticBody2D* sb, FrameArena* arena) {
         // ? The normal points towards B and away from A so we want to pass the rigid body's colliders second.
 
         switch(sb->colliderType) {
             case STATIC_CIRCLE_COLLIDER: {
                 switch(rb->colliderType) {
-                    case RIGID_CIRCLE_COLLIDER: { return findCollisionFeatures(sb->collider.circle, rb->collider.circle); }
-                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.circle, rb->collider.aabb); }
-                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.circle, rb->collider.box); }
+                    case RIGID_CIRCLE_COLLIDER: { return findCollisionFeatures(sb->collider.circle, rb->collider.circle, arena); }
+                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.circle, rb->collider.aabb, arena); }
+                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.circle, rb->collider.box, arena); }
                 }
             }
 
             case STATIC_AABB_COLLIDER: {
                 switch(rb->colliderType) {
                     case RIGID_CIRCLE_COLLIDER: {
-                        CollisionManifold manifold = findCollisionFeatures(rb->collider.circle, sb->collider.aabb);
+                        CollisionManifold manifold = findCollisionFeatures(rb->collider.circle, sb->collider.aabb, arena);
                         manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                         return manifold;
                     }
 
-                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, rb->collider.aabb); }
-                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, rb->collider.box); }
+                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, rb->collider.aabb, arena); }
+                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, rb->collider.box, arena); }
                 }
             }
 
             case STATIC_BOX2D_COLLIDER: {
                 switch(rb->colliderType) {
                     case RIGID_CIRCLE_COLLIDER: {
-                        CollisionManifold manifold = findCollisionFeatures(rb->collider.circle, sb->collider.box);
+                        CollisionManifold manifold = findCollisionFeatures(rb->collider.circle, sb->collider.box, arena);
                         manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                         return manifold;
                     }
 
                     case RIGID_AABB_COLLIDER: {
-                        CollisionManifold manifold = findCollisionFeatures(rb->collider.aabb, sb->collider.box);
+                        CollisionManifold manifold = findCollisionFeatures(rb->collider.aabb, sb->collider.box, arena);
                         manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                         return manifold;
                     }
 
-                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.box, rb->collider.box); }
+                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.box, rb->collider.box, arena); }
                 }
             }
 
@@ -809,46 +815,46 @@ namespace Zeta {
 
     // Find the collision features between a rigid and kinematic body.
     // The normal will point away from the kinematic body and towards the rigid body.
-    CollisionManifold findCollisionFeatures(RigidBody2D* rb, KinematicBody2D* kb) {
+    CollisionManifold findCollisionFeatures(RigidBody2D* rb, KinematicBody2D* kb, FrameArena* arena) {
         // ? The normal points towards B and away from A so we want to pass the rb's collider second.
 
         switch(kb->colliderType) {
             case KINEMATIC_CIRCLE_COLLIDER: {
                 switch(rb->colliderType) {
-                    case RIGID_CIRCLE_COLLIDER: { return findCollisionFeatures(kb->collider.circle, rb->collider.circle); }
-                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(kb->collider.circle, rb->collider.aabb); }
-                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(kb->collider.circle, rb->collider.box); }
+                    case RIGID_CIRCLE_COLLIDER: { return findCollisionFeatures(kb->collider.circle, rb->collider.circle, arena); }
+                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(kb->collider.circle, rb->collider.aabb, arena); }
+                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(kb->collider.circle, rb->collider.box, arena); }
                 }
             }
 
             case KINEMATIC_AABB_COLLIDER: {
                 switch(rb->colliderType) {
                     case RIGID_CIRCLE_COLLIDER: {
-                        CollisionManifold result = findCollisionFeatures(rb->collider.circle, kb->collider.aabb);
+                        CollisionManifold result = findCollisionFeatures(rb->collider.circle, kb->collider.aabb, arena);
                         result.normal = -result.normal;
                         return result;
                     }
 
-                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(kb->collider.aabb, rb->collider.aabb); }
-                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(kb->collider.aabb, rb->collider.box); }
+                    case RIGID_AABB_COLLIDER: { return findCollisionFeatures(kb->collider.aabb, rb->collider.aabb, arena); }
+                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(kb->collider.aabb, rb->collider.box, arena); }
                 }
             }
 
             case KINEMATIC_BOX2D_COLLIDER: {
                 switch(rb->colliderType) {
                     case RIGID_CIRCLE_COLLIDER: {
-                        CollisionManifold result = findCollisionFeatures(rb->collider.circle, kb->collider.box);
+                        CollisionManifold result = findCollisionFeatures(rb->collider.circle, kb->collider.box, arena);
                         result.normal = -result.normal;
                         return result;
                     }
 
                     case RIGID_AABB_COLLIDER: {
-                        CollisionManifold result = findCollisionFeatures(rb->collider.aabb, kb->collider.box);
+                        CollisionManifold result = findCollisionFeatures(rb->collider.aabb, kb->collider.box, arena);
                         result.normal = -result.normal;
                         return result;
                     }
 
-                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(kb->collider.box, rb->collider.box); }
+                    case RIGID_BOX2D_COLLIDER: { return findCollisionFeatures(kb->collider.box, rb->collider.box, arena); }
                 }
             }
 
@@ -863,46 +869,46 @@ namespace Zeta {
 
     // Find the collision features between a kinematic and static body.
     // The normal will point away from the static body and towards the kinematic body.
-    CollisionManifold findCollisionFeatures(KinematicBody2D* kb, StaticBody2D* sb) {
+    CollisionManifold findCollisionFeatures(KinematicBody2D* kb, StaticBody2D* sb, FrameArena* arena) {
         // ? The normal points towards B and away from A so we want to pass the rigid body's colliders second.
 
         switch(sb->colliderType) {
             case STATIC_CIRCLE_COLLIDER: {
                 switch(kb->colliderType) {
-                    case KINEMATIC_CIRCLE_COLLIDER: { return findCollisionFeatures(sb->collider.circle, kb->collider.circle); }
-                    case KINEMATIC_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.circle, kb->collider.aabb); }
-                    case KINEMATIC_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.circle, kb->collider.box); }
+                    case KINEMATIC_CIRCLE_COLLIDER: { return findCollisionFeatures(sb->collider.circle, kb->collider.circle, arena); }
+                    case KINEMATIC_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.circle, kb->collider.aabb, arena); }
+                    case KINEMATIC_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.circle, kb->collider.box, arena); }
                 }
             }
 
             case STATIC_AABB_COLLIDER: {
                 switch(kb->colliderType) {
                     case KINEMATIC_CIRCLE_COLLIDER: {
-                        CollisionManifold manifold = findCollisionFeatures(kb->collider.circle, sb->collider.aabb);
+                        CollisionManifold manifold = findCollisionFeatures(kb->collider.circle, sb->collider.aabb, arena);
                         manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                         return manifold;
                     }
 
-                    case KINEMATIC_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, kb->collider.aabb); }
-                    case KINEMATIC_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, kb->collider.box); }
+                    case KINEMATIC_AABB_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, kb->collider.aabb, arena); }
+                    case KINEMATIC_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.aabb, kb->collider.box, arena); }
                 }
             }
 
             case STATIC_BOX2D_COLLIDER: {
                 switch(kb->colliderType) {
                     case KINEMATIC_CIRCLE_COLLIDER: {
-                        CollisionManifold manifold = findCollisionFeatures(kb->collider.circle, sb->collider.box);
+                        CollisionManifold manifold = findCollisionFeatures(kb->collider.circle, sb->collider.box, arena);
                         manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                         return manifold;
                     }
 
                     case KINEMATIC_AABB_COLLIDER: {
-                        CollisionManifold manifold = findCollisionFeatures(kb->collider.aabb, sb->collider.box);
+                        CollisionManifold manifold = findCollisionFeatures(kb->collider.aabb, sb->collider.box, arena);
                         manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                         return manifold;
                     }
 
-                    case KINEMATIC_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.box, kb->collider.box); }
+                    case KINEMATIC_BOX2D_COLLIDER: { return findCollisionFeatures(sb->collider.box, kb->collider.box, arena); }
                 }
             }
 
@@ -917,43 +923,43 @@ namespace Zeta {
 
     // Find the collision features between two kinematic bodies.
     // The normal points towards B and away from A.
-    CollisionManifold findCollisionFeatures(KinematicBody2D* kb1, KinematicBody2D* kb2) {
+    CollisionManifold findCollisionFeatures(KinematicBody2D* kb1, KinematicBody2D* kb2, FrameArena* arena) {
         switch (kb1->colliderType) {
             case KINEMATIC_CIRCLE_COLLIDER: {
-                if (kb2->colliderType == KINEMATIC_CIRCLE_COLLIDER) { return findCollisionFeatures(kb1->collider.circle, kb2->collider.circle); }
-                if (kb2->colliderType == KINEMATIC_AABB_COLLIDER) { return findCollisionFeatures(kb1->collider.circle, kb2->collider.aabb); }
-                if (kb2->colliderType == KINEMATIC_BOX2D_COLLIDER) { return findCollisionFeatures(kb1->collider.circle, kb2->collider.box); }
+                if (kb2->colliderType == KINEMATIC_CIRCLE_COLLIDER) { return findCollisionFeatures(kb1->collider.circle, kb2->collider.circle, arena); }
+                if (kb2->colliderType == KINEMATIC_AABB_COLLIDER) { return findCollisionFeatures(kb1->collider.circle, kb2->collider.aabb, arena); }
+                if (kb2->colliderType == KINEMATIC_BOX2D_COLLIDER) { return findCollisionFeatures(kb1->collider.circle, kb2->collider.box, arena); }
 
                 break;
             }
 
             case KINEMATIC_AABB_COLLIDER: {
                 if (kb2->colliderType == KINEMATIC_CIRCLE_COLLIDER) {
-                    CollisionManifold manifold = findCollisionFeatures(kb2->collider.circle, kb1->collider.aabb);
+                    CollisionManifold manifold = findCollisionFeatures(kb2->collider.circle, kb1->collider.aabb, arena);
                     manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                     return manifold;
                 }
 
-                if (kb2->colliderType == KINEMATIC_AABB_COLLIDER) { return findCollisionFeatures(kb1->collider.aabb, kb2->collider.aabb); }
-                if (kb2->colliderType == KINEMATIC_BOX2D_COLLIDER) { return findCollisionFeatures(kb1->collider.aabb, kb2->collider.box); }
+                if (kb2->colliderType == KINEMATIC_AABB_COLLIDER) { return findCollisionFeatures(kb1->collider.aabb, kb2->collider.aabb, arena); }
+                if (kb2->colliderType == KINEMATIC_BOX2D_COLLIDER) { return findCollisionFeatures(kb1->collider.aabb, kb2->collider.box, arena); }
 
                 break;
             }
 
             case KINEMATIC_BOX2D_COLLIDER: {
                 if (kb2->colliderType == KINEMATIC_CIRCLE_COLLIDER) {
-                    CollisionManifold manifold = findCollisionFeatures(kb2->collider.circle, kb1->collider.box);
+                    CollisionManifold manifold = findCollisionFeatures(kb2->collider.circle, kb1->collider.box, arena);
                     manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                     return manifold;
                 }
 
                 if (kb2->colliderType == KINEMATIC_AABB_COLLIDER) {
-                    CollisionManifold manifold = findCollisionFeatures(kb2->collider.aabb, kb1->collider.box);
+                    CollisionManifold manifold = findCollisionFeatures(kb2->collider.aabb, kb1->collider.box, arena);
                     manifold.normal = -manifold.normal; // flip the direction as the original order passed in was reversed
                     return manifold;
                 }
 
-                if (kb2->colliderType == KINEMATIC_BOX2D_COLLIDER) { return findCollisionFeatures(kb1->collider.box, kb2->collider.box); }
+                if (kb2->colliderType == KINEMATIC_BOX2D_COLLIDER) { return findCollisionFeatures(kb1->collider.box, kb2->collider.box, arena); }
 
                 break;
             }
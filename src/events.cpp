@@ -0,0 +1,57 @@
+#include <ZETA/events.h>
+
+namespace Zeta {
+    // * ====================================
+    // * Contact Event Queue (SPSC)
+    // * ====================================
+
+    ContactEventQueue::ContactEventQueue(int capacity, std::pmr::memory_resource* resource)
+        : resource(resource), head(0), tail(0), pendingTail(0), cachedHead(0), dropped(0) {
+        unsigned int size = 1;
+        while ((int) size < capacity) { size <<= 1; }
+
+        events = allocArray<ContactEvent>(resource, size);
+        mask = size - 1;
+    };
+
+    ContactEventQueue::~ContactEventQueue() { freeArray(resource, events, mask + 1); };
+
+    bool ContactEventQueue::push(ContactEvent const &event) {
+        // ? Only reload head from the consumer when the queue looks full to keep the cache line traffic down.
+
+        if (pendingTail - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+
+            if (pendingTail - cachedHead > mask) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return 0;
+            }
+        }
+
+        events[pendingTail & mask] = event;
+        ++pendingTail;
+        return 1;
+    };
+
+    void ContactEventQueue::publish() { tail.store(pendingTail, std::memory_order_release); };
+
+    bool ContactEventQueue::pop(ContactEvent &event) {
+        unsigned int h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) { return 0; }
+
+        event = events[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return 1;
+    };
+
+    int ContactEventQueue::pop(ContactEvent* out, int max) {
+        unsigned int h = head.load(std::memory_order_relaxed);
+        unsigned int available = tail.load(std::memory_order_acquire) - h;
+        int n = (int) available < max ? (int) available : max;
+
+        for (int i = 0; i < n; ++i) { out[i] = events[(h + i) & mask]; }
+
+        head.store(h + n, std::memory_order_release);
+        return n;
+    };
+}
@@ -1,4 +1,5 @@
 #include <ZETA/intersections.h>
+#include <cfloat>
 
 namespace Zeta {
     // * ===================================
@@ -269,6 +270,129 @@ namespace Zeta {
         return raycast(newBox2D, newRay, d2);
     };
 
+    // Determine if a ray intersects a circle.
+    // dist will be set to the distance along the ray to the hit point and normal to the circle's surface normal at that point.
+    // dist is set to -1 if there is no intersection.
+    bool raycast(Circle const &circle, Ray2D const &ray, float &dist, ZMath::Vec2D &normal) {
+        // ? Solve |origin + t*dir - center|^2 = r^2 for t.
+        // ? Since dir is normalized this reduces to t^2 + 2bt + c = 0.
+
+        ZMath::Vec2D m = ray.origin - circle.c;
+        float b = m * ray.dir;
+        float c = m.magSq() - circle.r*circle.r;
+
+        // the ray starts outside of the circle and points away from it
+        if (c > 0.0f && b > 0.0f) {
+            dist = -1.0f;
+            return 0;
+        }
+
+        float disc = b*b - c;
+
+        // the ray misses the circle
+        if (disc < 0.0f) {
+            dist = -1.0f;
+            return 0;
+        }
+
+        float root = sqrtf(disc);
+
+        // if the ray starts inside the circle, we want the exit point
+        dist = c > 0.0f ? -b - root : -b + root;
+        normal = (m + ray.dir * dist) * (1.0f/circle.r);
+
+        return 1;
+    };
+
+    // Slab test shared by the AABB and Box2D raycasts. min, max, origin, and dir must all be in the same space.
+    static bool raycastSlabs(ZMath::Vec2D const &min, ZMath::Vec2D const &max, ZMath::Vec2D const &origin,
+                             ZMath::Vec2D const &dir, float &dist, ZMath::Vec2D &normal) {
+
+        float tMin = -FLT_MAX, tMax = FLT_MAX;
+        ZMath::Vec2D nMin, nMax; // normals of the faces the ray enters and exits through
+
+        // * x slab
+        if (std::fabs(dir.x) < 1e-8f) {
+            if (origin.x < min.x || origin.x > max.x) {
+                dist = -1.0f;
+                return 0;
+            }
+
+        } else {
+            float inv = 1.0f/dir.x;
+            float t1 = (min.x - origin.x)*inv, t2 = (max.x - origin.x)*inv;
+
+            if (inv >= 0.0f) {
+                tMin = t1; nMin.set(-1, 0);
+                tMax = t2; nMax.set(1, 0);
+
+            } else {
+                tMin = t2; nMin.set(1, 0);
+                tMax = t1; nMax.set(-1, 0);
+            }
+        }
+
+        // * y slab
+        if (std::fabs(dir.y) < 1e-8f) {
+            if (origin.y < min.y || origin.y > max.y) {
+                dist = -1.0f;
+                return 0;
+            }
+
+        } else {
+            float inv = 1.0f/dir.y;
+            float t1 = (min.y - origin.y)*inv, t2 = (max.y - origin.y)*inv;
+            ZMath::Vec2D n1(0, -1), n2(0, 1);
+
+            if (inv < 0.0f) {
+                float temp = t1; t1 = t2; t2 = temp;
+                n1.set(0, 1); n2.set(0, -1);
+            }
+
+            if (t1 > tMin) { tMin = t1; nMin = n1; }
+            if (t2 < tMax) { tMax = t2; nMax = n2; }
+        }
+
+        // the ray misses or the box is behind the ray
+        if (tMax < tMin || tMax < 0.0f) {
+            dist = -1.0f;
+            return 0;
+        }
+
+        // ray's origin is inside of the box
+        if (tMin < 0.0f) {
+            dist = tMax;
+            normal = nMax;
+            return 1;
+        }
+
+        dist = tMin;
+        normal = nMin;
+        return 1;
+    };
+
+    // Determine if a ray intersects an AABB.
+    // dist will be set to the distance along the ray to the hit point and normal to the AABB's surface normal at that point.
+    // dist is set to -1 if there is no intersection.
+    bool raycast(AABB const &aabb, Ray2D const &ray, float &dist, ZMath::Vec2D &normal) {
+        return raycastSlabs(aabb.getMin(), aabb.getMax(), ray.origin, ray.dir, dist, normal);
+    };
+
+    // Determine if a ray intersects a Box2D.
+    // dist will be set to the distance along the ray to the hit point and normal to the Box2D's surface normal at that point.
+    // dist is set to -1 if there is no intersection.
+    bool raycast(Box2D const &box, Ray2D const &ray, float &dist, ZMath::Vec2D &normal) {
+        // ? Rotate the ray into the Box2D's local space, perform the slab test, and rotate the normal back.
+
+        ZMath::Mat2D rotT = box.rot.transpose();
+        ZMath::Vec2D h = box.getHalfsize();
+
+        if (!raycastSlabs(-h, h, rotT * (ray.origin - box.pos), rotT * ray.dir, dist, normal)) { return 0; }
+
+        normal = box.rot * normal;
+        return 1;
+    };
+
     // * ===================================
     // * Circle vs Primitives
     // * ===================================
@@ -329,8 +453,10 @@ namespace Zeta {
         ZMath::Vec2D min = box.getLocalMin(), max = box.getLocalMax();
 
         closest = box.rot.transpose() * closest + box.pos;
+        ZMath::Vec2D center = closest; // circle's center in the box's UV coords
+
         closest = ZMath::clamp(closest, min, max);
-        return closest.distSq(circle.c) <= circle.r*circle.r;
+        return closest.distSq(center) <= circle.r*circle.r;
     };
 
     // Check for intersection and return the collision normal.
@@ -341,20 +467,22 @@ namespace Zeta {
         ZMath::Vec2D min = box.getLocalMin(), max = box.getLocalMax();
 
         // rotate the center of the circle into the UV coordinates of our Box2D
-        closest = box.rot * closest + box.pos;
+        closest = box.rot.transpose() * closest + box.pos;
+        ZMath::Vec2D center = closest;
         
         // perform the check as if it was an AABB vs circle
         closest = ZMath::clamp(closest, min, max);
-        ZMath::Vec2D diff = closest - circle.c;
+        ZMath::Vec2D diff = closest - center;
 
         if (diff.magSq() > circle.r*circle.r) { return 0; }
 
         // the closest point to the circle's center will be our contact point rotated back into global coordinates coordinates
 
         closest -= box.pos;
-        closest = box.rot.transpose() * closest + box.pos;
+        closest = box.rot * closest + box.pos;
 
-        normal = diff.normalize();
+        // the normal was found in the box's UV coords so rotate it back into global coordinates
+        normal = box.rot * diff.normalize();
 
         return 1;
     };
@@ -435,11 +563,11 @@ namespace Zeta {
         // * Check for intersection using the separating axis theorem
 
         // amount of penetration along A's axes
-        ZMath::Vec2D faceA = ZMath::abs(dA) - hA - hB;
+        ZMath::Vec2D faceA = ZMath::abs(dA) - hA - ZMath::abs(box.rot) * hB;
         if (faceA.x > 0 || faceA.y > 0) { return 0; }
 
         // amount of penetration along B's axes
-        ZMath::Vec2D faceB = ZMath::abs(dB) - hB - rotBT * hA;
+        ZMath::Vec2D faceB = ZMath::abs(dB) - hB - ZMath::abs(rotBT) * hA;
         return faceB.x <= 0 && faceB.y <= 0;
     };
 
@@ -462,11 +590,11 @@ namespace Zeta {
         // * Check for intersection using the separating axis theorem
 
         // amount of penetration along A's axes
-        ZMath::Vec2D faceA = ZMath::abs(dA) - hA - hB;
+        ZMath::Vec2D faceA = ZMath::abs(dA) - hA - ZMath::abs(box.rot) * hB;
         if (faceA.x > 0 || faceA.y > 0) { return 0; }
 
         // amount of penetration along B's axes
-        ZMath::Vec2D faceB = ZMath::abs(dB) - hB - rotBT * hA;
+        ZMath::Vec2D faceB = ZMath::abs(dB) - hB - ZMath::abs(rotBT) * hA;
         if (faceB.x > 0 || faceB.y > 0) { return 0; }
         
         // * Find the best axis (i.e. the axis with the least amount of penetration).
@@ -613,4 +741,135 @@ namespace Zeta {
 
         return 1;
     };
+
+    // * ===================================
+    // * Body vs Body
+    // * ===================================
+
+    // ? The rigid, static, and kinematic collider enums all list circle, AABB, and Box2D in the same order
+    // ?  and each collider union stores its primitive at the start of the union.
+    // ? This lets us share a single dispatcher between all of the body types.
+
+    static bool collidersIntersect(int type1, void const* collider1, int type2, void const* collider2) {
+        switch (type1) {
+            case RIGID_CIRCLE_COLLIDER: {
+                Circle const &circle = *((Circle const*) collider1);
+
+                if (type2 == RIGID_CIRCLE_COLLIDER) { return CircleAndCircle(circle, *((Circle const*) collider2)); }
+                if (type2 == RIGID_AABB_COLLIDER) { return CircleAndAABB(circle, *((AABB const*) collider2)); }
+                if (type2 == RIGID_BOX2D_COLLIDER) { return CircleAndBox2D(circle, *((Box2D const*) collider2)); }
+
+                break;
+            }
+
+            case RIGID_AABB_COLLIDER: {
+                AABB const &aabb = *((AABB const*) collider1);
+
+                if (type2 == RIGID_CIRCLE_COLLIDER) { return CircleAndAABB(*((Circle const*) collider2), aabb); }
+                if (type2 == RIGID_AABB_COLLIDER) { return AABBAndAABB(aabb, *((AABB const*) collider2)); }
+                if (type2 == RIGID_BOX2D_COLLIDER) { return AABBAndBox2D(aabb, *((Box2D const*) collider2)); }
+
+                break;
+            }
+
+            case RIGID_BOX2D_COLLIDER: {
+                Box2D const &box = *((Box2D const*) collider1);
+
+                if (type2 == RIGID_CIRCLE_COLLIDER) { return CircleAndBox2D(*((Circle const*) collider2), box); }
+                if (type2 == RIGID_AABB_COLLIDER) { return AABBAndBox2D(*((AABB const*) collider2), box); }
+                if (type2 == RIGID_BOX2D_COLLIDER) { return Box2DAndBox2D(box, *((Box2D const*) collider2)); }
+
+                break;
+            }
+        }
+
+        // * User defined colliders go here.
+
+        return 0;
+    };
+
+    // Same as above but also find the collision normal. It will point towards collider2 and away from collider1.
+    static bool collidersIntersect(int type1, void const* collider1, int type2, void const* collider2, ZMath::Vec2D &normal) {
+        switch (type1) {
+            case RIGID_CIRCLE_COLLIDER: {
+                Circle const &circle = *((Circle const*) collider1);
+
+                if (type2 == RIGID_CIRCLE_COLLIDER) { return CircleAndCircle(circle, *((Circle const*) collider2), normal); }
+                if (type2 == RIGID_AABB_COLLIDER) { return CircleAndAABB(circle, *((AABB const*) collider2), normal); }
+                if (type2 == RIGID_BOX2D_COLLIDER) { return CircleAndBox2D(circle, *((Box2D const*) collider2), normal); }
+
+                break;
+            }
+
+            case RIGID_AABB_COLLIDER: {
+                AABB const &aabb = *((AABB const*) collider1);
+
+                if (type2 == RIGID_CIRCLE_COLLIDER) { return AABBAndCircle(aabb, *((Circle const*) collider2), normal); }
+                if (type2 == RIGID_AABB_COLLIDER) { return AABBAndAABB(aabb, *((AABB const*) collider2), normal); }
+                if (type2 == RIGID_BOX2D_COLLIDER) { return AABBAndBox2D(aabb, *((Box2D const*) collider2), normal); }
+
+                break;
+            }
+
+            case RIGID_BOX2D_COLLIDER: {
+                Box2D const &box = *((Box2D const*) collider1);
+
+                if (type2 == RIGID_CIRCLE_COLLIDER) { return Box2DAndCircle(box, *((Circle const*) collider2), normal); }
+                if (type2 == RIGID_BOX2D_COLLIDER) { return Box2DAndBox2D(box, *((Box2D const*) collider2), normal); }
+
+                if (type2 == RIGID_AABB_COLLIDER) {
+                    bool hit = AABBAndBox2D(*((AABB const*) collider2), box, normal);
+                    normal = -normal;
+                    return hit;
+                }
+
+                break;
+            }
+        }
+
+        // * User defined colliders go here.
+
+        return 0;
+    };
+
+    // Determine if the colliders of two rigid bodies intersect.
+    bool RigidAndRigid(RigidBody2D* rb1, RigidBody2D* rb2) {
+        return collidersIntersect(rb1->colliderType, &rb1->collider, rb2->colliderType, &rb2->collider);
+    };
+
+    // Determine if the colliders of a rigid and static body intersect.
+    bool RigidAndStatic(RigidBody2D* rb, StaticBody2D* sb) {
+        return collidersIntersect(rb->colliderType, &rb->collider, sb->colliderType, &sb->collider);
+    };
+
+    // Determine if the colliders of a rigid and kinematic body intersect.
+    bool RigidAndKinematic(RigidBody2D* rb, KinematicBody2D* kb) {
+        return collidersIntersect(rb->colliderType, &rb->collider, kb->colliderType, &kb->collider);
+    };
+
+    // Determine if the colliders of a kinematic and static body intersect.
+    bool KinematicAndStatic(KinematicBody2D* kb, StaticBody2D* sb) {
+        return collidersIntersect(kb->colliderType, &kb->collider, sb->colliderType, &sb->collider);
+    };
+
+    // Determine if the colliders of two kinematic bodies intersect.
+    bool KinematicAndKinematic(KinematicBody2D* kb1, KinematicBody2D* kb2) {
+        return collidersIntersect(kb1->colliderType, &kb1->collider, kb2->colliderType, &kb2->collider);
+    };
+
+    // Determine if a body's collider intersects a primitive.
+    bool BodyAndCollider(BodyRef const &ref, int type, void const* collider) {
+        int bodyType;
+        void const* bodyCollider = getCollider(ref, bodyType);
+
+        return collidersIntersect(bodyType, bodyCollider, type, collider);
+    };
+
+    // Check for intersection between a body's collider and a primitive and return the collision normal.
+    bool BodyAndCollider(BodyRef const &ref, int type, void const* collider, ZMath::Vec2D &normal) {
+        int bodyType;
+        void const* bodyCollider = getCollider(ref, bodyType);
+
+        return collidersIntersect(bodyType, bodyCollider, type, collider, normal);
+    };
 }
@@ -1,4 +1,8 @@
 #include <ZETA/physicshandler.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
 
 // todo add in move semantics
 
@@ -52,6 +56,235 @@ namespace Zeta {
 
     // todo -----------------------------------------------------------------------------------------------------------------------------
 
+    // Resolve a speculative contact between two rigidbodies.
+    void applySpeculativeImpulse(RigidBody2D* rb1, RigidBody2D* rb2, CollisionManifold const &manifold, float dt) {
+        // the normal points towards rb2 so a positive value means they are approaching each other
+        float closing = (rb1->vel - rb2->vel) * manifold.normal + manifold.pDist/dt;
+        if (closing <= 0.0f) { return; }
+
+        float J = closing/(rb1->invMass + rb2->invMass);
+
+        rb1->vel -= manifold.normal * (rb1->invMass * J);
+        rb2->vel += manifold.normal * (rb2->invMass * J);
+    };
+
+    // Resolve a speculative contact between a rigid and static body.
+    void applySpeculativeImpulse(RigidBody2D* rb, StaticBody2D*, CollisionManifold const &manifold, float dt) {
+        // the normal points towards rb so a negative value means it is approaching
+        float closing = -(rb->vel * manifold.normal) + manifold.pDist/dt;
+        if (closing > 0.0f) { rb->vel += manifold.normal * closing; }
+    };
+
+    // Resolve a speculative contact between a rigid and kinematic body.
+    void applySpeculativeImpulse(RigidBody2D* rb, KinematicBody2D* kb, CollisionManifold const &manifold, float dt) {
+        float closing = -((rb->vel - kb->vel) * manifold.normal) + manifold.pDist/dt;
+        if (closing > 0.0f) { rb->vel += manifold.normal * closing; }
+    };
+
+
+    // * =========================
+    // * Cached Bounds
+    // * =========================
+
+    // Check if the cached bounds of two bodies overlap. Bodies whose bounds do not overlap cannot be touching.
+    // ? The narrowphase rounds differently than the bounds, so bodies resting exactly against each other can be a hit there
+    // ?  while their bounds miss by a hair. Allowing a gap of EPSILON keeps those contacts.
+    template <typename A, typename B>
+    static inline bool boundsOverlap(A const* a, B const* b) {
+        float const margin = EPSILON;
+
+        return a->boundsMin.x <= b->boundsMax.x + margin && b->boundsMin.x <= a->boundsMax.x + margin &&
+               a->boundsMin.y <= b->boundsMax.y + margin && b->boundsMin.y <= a->boundsMax.y + margin;
+    };
+
+
+    // * =========================
+    // * Speculative Contacts
+    // * =========================
+
+    // Velocity a rigid body will move with during the next step.
+    static inline ZMath::Vec2D predictVel(RigidBody2D const* rb, ZMath::Vec2D const &g, float dt) {
+        return rb->vel + (g + rb->netForce * rb->invMass) * dt;
+    };
+
+    // Check if the cached bounds of two bodies overlap once each is grown by how far it moves during the step.
+    // Pairs that fail this cannot meet during the step, so they cannot have a speculative contact.
+    template <typename A, typename B>
+    static inline bool sweptBoundsOverlap(A const* a, ZMath::Vec2D const &dispA, B const* b, ZMath::Vec2D const &dispB) {
+        ZMath::Vec2D minA = a->boundsMin + ZMath::Vec2D(MIN(dispA.x, 0.0f), MIN(dispA.y, 0.0f));
+        ZMath::Vec2D maxA = a->boundsMax + ZMath::Vec2D(MAX(dispA.x, 0.0f), MAX(dispA.y, 0.0f));
+        ZMath::Vec2D minB = b->boundsMin + ZMath::Vec2D(MIN(dispB.x, 0.0f), MIN(dispB.y, 0.0f));
+        ZMath::Vec2D maxB = b->boundsMax + ZMath::Vec2D(MAX(dispB.x, 0.0f), MAX(dispB.y, 0.0f));
+
+        return minA.x <= maxB.x && minB.x <= maxA.x && minA.y <= maxB.y && minB.y <= maxA.y;
+    };
+
+    // Find a speculative contact between a rigid body and a body it is not touching yet.
+    // disp is how far the rigid body moves relative to the other body over dt. The normal will point towards the rigid body.
+    // ? The impulse treats pDist/updateStep as the speed the bodies may still close at. A body stepped less often by its level
+    // ?  of detail closes the gap over its longer dt, so the gap is scaled to updateStep to let it move the whole way.
+    static bool findSpeculativeContact(RigidBody2D* rb, BodyRef const &other, ZMath::Vec2D const &disp, float dt, float updateStep,
+                                       CollisionManifold &manifold) {
+
+        float len = disp.mag();
+        if (len == 0.0f) { return 0; }
+
+        ZMath::Vec2D dir = disp * (1.0f/len);
+        float dist;
+
+        if (!shapecast(other, rb->colliderType, &rb->collider, dir, len, dist, manifold.normal)) { return 0; }
+
+        // the gap along the normal is how far the sweep travelled projected onto it
+        manifold.pDist = dist * (manifold.normal * dir) * (updateStep/dt);
+        manifold.contactPoints = nullptr;
+        manifold.numPoints = 0;
+        manifold.hit = 1;
+
+        return 1;
+    };
+
+
+    // * =========================
+    // * Body Pair Helpers
+    // * =========================
+
+    // Make sure n pairs fit without reallocating. The existing pairs are kept.
+    static void reservePairs(std::pmr::memory_resource* resource, BodyPairs &pairs, int n) {
+        if (n <= pairs.capacity) { return; }
+
+        int oldCapacity = pairs.capacity;
+        do { pairs.capacity *= 2; } while (n > pairs.capacity);
+
+        BodyRef* temp1 = allocArray<BodyRef>(resource, pairs.capacity);
+        BodyRef* temp2 = allocArray<BodyRef>(resource, pairs.capacity);
+
+        for (int i = 0; i < pairs.count; ++i) {
+            temp1[i] = pairs.first[i];
+            temp2[i] = pairs.second[i];
+        }
+
+        freeArray(resource, pairs.first, oldCapacity);
+        freeArray(resource, pairs.second, oldCapacity);
+
+        pairs.first = temp1;
+        pairs.second = temp2;
+    };
+
+    // Add a pair of bodies to a list of body pairs.
+    static void addPair(std::pmr::memory_resource* resource, BodyPairs &pairs, BodyRef const &first, BodyRef const &second) {
+        if (pairs.count == pairs.capacity) { reservePairs(resource, pairs, pairs.count + 1); }
+
+        pairs.first[pairs.count] = first;
+        pairs.second[pairs.count++] = second;
+    };
+
+    // Make sure a pair table fits n pairs without reallocating.
+    static void reservePairTable(std::pmr::memory_resource* resource, PairTable &table, int n) {
+        if (table.slotCapacity < 2*n) {
+            freeArray(resource, table.slots, table.slotCapacity);
+
+            do { table.slotCapacity *= 2; } while (table.slotCapacity < 2*n);
+            table.slots = allocArray<int>(resource, table.slotCapacity);
+        }
+
+        if (table.capacity < n) {
+            freeArray(resource, table.matched, table.capacity);
+
+            table.capacity = n;
+            table.matched = allocArray<bool>(resource, table.capacity);
+        }
+    };
+
+    // Make sure n events fit in a list of events without reallocating. The existing events are kept.
+    template <typename Events>
+    static void reserveEvents(std::pmr::memory_resource* resource, Events &events, int n) {
+        if (n <= events.capacity) { return; }
+
+        int oldCapacity = events.capacity;
+        do { events.capacity *= 2; } while (n > events.capacity);
+
+        auto* temp = allocArray<std::remove_pointer_t<decltype(events.events)>>(resource, events.capacity);
+        for (int i = 0; i < events.count; ++i) { temp[i] = events.events[i]; }
+
+        freeArray(resource, events.events, oldCapacity);
+        events.events = temp;
+    };
+
+    // Remove every pair involving a body removed(body) returns 1 for while maintaining the order of the remaining pairs.
+    template <typename F>
+    static void removePairs(BodyPairs &pairs, F const &removed) {
+        int count = 0;
+
+        for (int i = 0; i < pairs.count; ++i) {
+            if (removed(pairs.first[i].body) || removed(pairs.second[i].body)) { continue; }
+
+            pairs.first[count] = pairs.first[i];
+            pairs.second[count++] = pairs.second[i];
+        }
+
+        pairs.count = count;
+    };
+
+    // Hash a pair of body pointers. The order of the pointers does not matter.
+    static inline unsigned int hashPair(void* first, void* second) {
+        // ? Which body of a pair comes first depends on where the bodies are in the handler's lists,
+        // ?  which reordering and despawning change while the bodies are still touching.
+        if (first > second) { std::swap(first, second); }
+
+        unsigned long long h = (unsigned long long) first * 0x9E3779B97F4A7C15ULL ^ (unsigned long long) second;
+        h ^= h >> 31;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 29;
+
+        return (unsigned int) h;
+    };
+
+    // Fill the pair table with the pairs passed in and reset the matched flags.
+    static void buildPairTable(std::pmr::memory_resource* resource, PairTable &table, BodyPairs const &pairs) {
+        // keep the load factor at or below 0.5 so probe sequences stay short
+        if (table.slotCapacity < 2*pairs.count) {
+            freeArray(resource, table.slots, table.slotCapacity);
+
+            do { table.slotCapacity *= 2; } while (table.slotCapacity < 2*pairs.count);
+            table.slots = allocArray<int>(resource, table.slotCapacity);
+        }
+
+        if (table.capacity < pairs.count) {
+            freeArray(resource, table.matched, table.capacity);
+
+            table.capacity = pairs.capacity;
+            table.matched = allocArray<bool>(resource, table.capacity);
+        }
+
+        for (int i = 0; i < table.slotCapacity; ++i) { table.slots[i] = -1; }
+
+        unsigned int mask = table.slotCapacity - 1;
+
+        for (int i = 0; i < pairs.count; ++i) {
+            unsigned int slot = hashPair(pairs.first[i].body, pairs.second[i].body) & mask;
+            while (table.slots[slot] != -1) { slot = (slot + 1) & mask; }
+
+            table.slots[slot] = i;
+            table.matched[i] = 0;
+        }
+    };
+
+    // Find the index of a pair in the pairs the table was built from in either order.
+    // Returns -1 if the pair is not present.
+    static int findPair(PairTable const &table, BodyPairs const &pairs, void* first, void* second) {
+        unsigned int mask = table.slotCapacity - 1;
+        unsigned int slot = hashPair(first, second) & mask;
+
+        while (table.slots[slot] != -1) {
+            int i = table.slots[slot];
+            if ((pairs.first[i].body == first && pairs.second[i].body == second) ||
+                (pairs.first[i].body == second && pairs.second[i].body == first)) { return i; }
+            slot = (slot + 1) & mask;
+        }
+
+        return -1;
+    };
+
 
     // * ========================
     // * Main Physics Handler
@@ -65,9 +298,9 @@ namespace Zeta {
         if (colWrapper.count == colWrapper.capacity) {
             colWrapper.capacity *= 2;
 
-            RigidBody2D** temp1 = new RigidBody2D*[colWrapper.capacity];
-            RigidBody2D** temp2 = new RigidBody2D*[colWrapper.capacity];
-            CollisionManifold* temp3 = new CollisionManifold[colWrapper.capacity];
+            RigidBody2D** temp1 = frameArena.alloc<RigidBody2D*>(colWrapper.capacity);
+            RigidBody2D** temp2 = frameArena.alloc<RigidBody2D*>(colWrapper.capacity);
+            CollisionManifold* temp3 = frameArena.alloc<CollisionManifold>(colWrapper.capacity);
 
             for (int i = 0; i < colWrapper.count; i++) {
                 temp1[i] = colWrapper.bodies1[i];
@@ -75,10 +308,7 @@ namespace Zeta {
                 temp3[i] = std::move(colWrapper.manifolds[i]);
             }
 
-            delete[] colWrapper.bodies1;
-            delete[] colWrapper.bodies2;
-            delete[] colWrapper.manifolds;
-
+            // the old arrays are freed along with the rest of the frame arena at the end of the step
             colWrapper.bodies1 = temp1;
             colWrapper.bodies2 = temp2;
             colWrapper.manifolds = temp3;
@@ -93,9 +323,9 @@ namespace Zeta {
         if (staticColWrapper.count == staticColWrapper.capacity) {
             staticColWrapper.capacity *= 2;
 
-            StaticBody2D** temp1 = new StaticBody2D*[staticColWrapper.capacity];
-            RigidBody2D** temp2 = new RigidBody2D*[staticColWrapper.capacity];
-            CollisionManifold* temp3 = new CollisionManifold[staticColWrapper.capacity];
+            StaticBody2D** temp1 = frameArena.alloc<StaticBody2D*>(staticColWrapper.capacity);
+            RigidBody2D** temp2 = frameArena.alloc<RigidBody2D*>(staticColWrapper.capacity);
+            CollisionManifold* temp3 = frameArena.alloc<CollisionManifold>(staticColWrapper.capacity);
 
             for (int i = 0; i < staticColWrapper.count; ++i) {
                 temp1[i] = staticColWrapper.sbs[i];
@@ -103,10 +333,6 @@ namespace Zeta {
                 temp3[i] = std::move(staticColWrapper.manifolds[i]);
             }
 
-            delete[] staticColWrapper.sbs;
-            delete[] staticColWrapper.rbs;
-            delete[] staticColWrapper.manifolds;
-
             staticColWrapper.sbs = temp1;
             staticColWrapper.rbs = temp2;
             staticColWrapper.manifolds = temp3;
@@ -121,9 +347,9 @@ namespace Zeta {
         if (rkColWrapper.count == rkColWrapper.capacity) {
             rkColWrapper.capacity *= 2;
 
-            RigidBody2D** temp1 = new RigidBody2D*[rkColWrapper.capacity];
-            KinematicBody2D** temp2 = new KinematicBody2D*[rkColWrapper.capacity];
-            CollisionManifold* temp3 = new CollisionManifold[rkColWrapper.capacity];
+            RigidBody2D** temp1 = frameArena.alloc<RigidBody2D*>(rkColWrapper.capacity);
+            KinematicBody2D** temp2 = frameArena.alloc<KinematicBody2D*>(rkColWrapper.capacity);
+            CollisionManifold* temp3 = frameArena.alloc<CollisionManifold>(rkColWrapper.capacity);
 
             for (int i = 0; i < rkColWrapper.count; ++i) {
                 temp1[i] = rkColWrapper.rbs[i];
@@ -131,10 +357,6 @@ namespace Zeta {
                 temp3[i] = std::move(rkColWrapper.manifolds[i]);
             }
 
-            delete[] rkColWrapper.rbs;
-            delete[] rkColWrapper.kbs;
-            delete[] rkColWrapper.manifolds;
-
             rkColWrapper.rbs = temp1;
             rkColWrapper.kbs = temp2;
             rkColWrapper.manifolds = temp3;
@@ -149,9 +371,9 @@ namespace Zeta {
         if (skColWrapper.count == skColWrapper.capacity) {
             skColWrapper.capacity *= 2;
 
-            StaticBody2D** temp1 = new StaticBody2D*[skColWrapper.capacity];
-            KinematicBody2D** temp2 = new KinematicBody2D*[skColWrapper.capacity];
-            CollisionManifold* temp3 = new CollisionManifold[skColWrapper.capacity];
+            StaticBody2D** temp1 = frameArena.alloc<StaticBody2D*>(skColWrapper.capacity);
+            KinematicBody2D** temp2 = frameArena.alloc<KinematicBody2D*>(skColWrapper.capacity);
+            CollisionManifold* temp3 = frameArena.alloc<CollisionManifold>(skColWrapper.capacity);
 
             for (int i = 0; i < skColWrapper.count; ++i) {
                 temp1[i] = skColWrapper.sbs[i];
@@ -159,10 +381,6 @@ namespace Zeta {
                 temp3[i] = std::move(skColWrapper.manifolds[i]);
             }
 
-            delete[] skColWrapper.sbs;
-            delete[] skColWrapper.kbs;
-            delete[] skColWrapper.manifolds;
-
             skColWrapper.sbs = temp1;
             skColWrapper.kbs = temp2;
             skColWrapper.manifolds = temp3;
@@ -177,9 +395,9 @@ namespace Zeta {
         if (kColWrapper.count == kColWrapper.capacity) {
             kColWrapper.capacity *= 2;
 
-            KinematicBody2D** temp1 = new KinematicBody2D*[kColWrapper.capacity];
-            KinematicBody2D** temp2 = new KinematicBody2D*[kColWrapper.capacity];
-            CollisionManifold* temp3 = new CollisionManifold[kColWrapper.capacity];
+            KinematicBody2D** temp1 = frameArena.alloc<KinematicBody2D*>(kColWrapper.capacity);
+            KinematicBody2D** temp2 = frameArena.alloc<KinematicBody2D*>(kColWrapper.capacity);
+            CollisionManifold* temp3 = frameArena.alloc<CollisionManifold>(kColWrapper.capacity);
 
             for (int i = 0; i < kColWrapper.count; ++i) {
                 temp1[i] = kColWrapper.kb1s[i];
@@ -187,10 +405,6 @@ namespace Zeta {
                 temp3[i] = std::move(kColWrapper.manifolds[i]);
             }
 
-            delete[] kColWrapper.kb1s;
-            delete[] kColWrapper.kb2s;
-            delete[] kColWrapper.manifolds;
-
             kColWrapper.kb1s = temp1;
             kColWrapper.kb2s = temp2;
             kColWrapper.manifolds = temp3;
@@ -202,85 +416,259 @@ namespace Zeta {
     };
 
     void Handler::clearCollisions() {
-        // ? We do not need to check for nullptrs because if this function is reached it is guarenteed none of the pointers inside of here will be NULL
+        // ? Everything allocated for the collisions of the last step lives in the frame arena, so it is all freed at once.
 
-        int halfRbs = rbs.capacity/2;
-        int halfKbs = kbs.capacity/2;
+        // once reserve has been called the lists have a fixed size so the arena never has to grow
+        int halfRbs = reservedContacts ? reservedContacts : rbs.capacity/2;
+        int halfKbs = reservedContacts ? reservedContacts : kbs.capacity/2;
 
+        frameArena.reset();
 
-        // * standard collision wrapper
-        delete[] colWrapper.bodies1;
-        delete[] colWrapper.bodies2;
-
-        for (int i = 0; i < colWrapper.count; ++i) { delete[] colWrapper.manifolds[i].contactPoints; }
-        delete[] colWrapper.manifolds;
 
-        colWrapper.bodies1 = new RigidBody2D*[halfRbs];
-        colWrapper.bodies2 = new RigidBody2D*[halfRbs];
-        colWrapper.manifolds = new CollisionManifold[halfRbs];
+        // * standard collision wrapper
+        colWrapper.bodies1 = frameArena.alloc<RigidBody2D*>(halfRbs);
+        colWrapper.bodies2 = frameArena.alloc<RigidBody2D*>(halfRbs);
+        colWrapper.manifolds = frameArena.alloc<CollisionManifold>(halfRbs);
 
         colWrapper.capacity = halfRbs;
         colWrapper.count = 0;
 
 
         // * Static collision wrapper
-        delete[] staticColWrapper.sbs;
-        delete[] staticColWrapper.rbs;
-
-        for (int i = 0; i < staticColWrapper.count; ++i) { delete[] staticColWrapper.manifolds[i].contactPoints; }
-        delete[] staticColWrapper.manifolds;
-
-        staticColWrapper.sbs = new StaticBody2D*[halfRbs];
-        staticColWrapper.rbs = new RigidBody2D*[halfRbs];
-        staticColWrapper.manifolds = new CollisionManifold[halfRbs];
+        staticColWrapper.sbs = frameArena.alloc<StaticBody2D*>(halfRbs);
+        staticColWrapper.rbs = frameArena.alloc<RigidBody2D*>(halfRbs);
+        staticColWrapper.manifolds = frameArena.alloc<CollisionManifold>(halfRbs);
 
         staticColWrapper.capacity = halfRbs;
         staticColWrapper.count = 0;
 
 
         // * Kinematic body collision wrappers
-        delete[] rkColWrapper.rbs;
-        delete[] rkColWrapper.kbs;
-        
-        for (int i = 0; i < rkColWrapper.count; ++i) { delete[] rkColWrapper.manifolds[i].contactPoints; }
-        delete[] rkColWrapper.manifolds;
-
-        rkColWrapper.rbs = new RigidBody2D*[halfKbs];
-        rkColWrapper.kbs = new KinematicBody2D*[halfKbs];
-        rkColWrapper.manifolds = new CollisionManifold[halfKbs];
+        rkColWrapper.rbs = frameArena.alloc<RigidBody2D*>(halfKbs);
+        rkColWrapper.kbs = frameArena.alloc<KinematicBody2D*>(halfKbs);
+        rkColWrapper.manifolds = frameArena.alloc<CollisionManifold>(halfKbs);
 
         rkColWrapper.capacity = halfKbs;
         rkColWrapper.count = 0;
 
 
-        delete[] skColWrapper.sbs;
-        delete[] skColWrapper.kbs;
-        
-        for (int i = 0; i < skColWrapper.count; ++i) { delete[] skColWrapper.manifolds[i].contactPoints; }
-        delete[] skColWrapper.manifolds;
-
-        skColWrapper.sbs = new StaticBody2D*[halfKbs];
-        skColWrapper.kbs = new KinematicBody2D*[halfKbs];
-        skColWrapper.manifolds = new CollisionManifold[halfKbs];
+        skColWrapper.sbs = frameArena.alloc<StaticBody2D*>(halfKbs);
+        skColWrapper.kbs = frameArena.alloc<KinematicBody2D*>(halfKbs);
+        skColWrapper.manifolds = frameArena.alloc<CollisionManifold>(halfKbs);
 
         skColWrapper.capacity = halfKbs;
         skColWrapper.count = 0;
 
 
-        delete[] kColWrapper.kb1s;
-        delete[] kColWrapper.kb2s;
-        
-        for (int i = 0; i < kColWrapper.count; ++i) { delete[] kColWrapper.manifolds[i].contactPoints; }
-        delete[] kColWrapper.manifolds;
-
-        kColWrapper.kb1s = new KinematicBody2D*[halfKbs];
-        kColWrapper.kb2s = new KinematicBody2D*[halfKbs];
-        kColWrapper.manifolds = new CollisionManifold[halfKbs];
+        kColWrapper.kb1s = frameArena.alloc<KinematicBody2D*>(halfKbs);
+        kColWrapper.kb2s = frameArena.alloc<KinematicBody2D*>(halfKbs);
+        kColWrapper.manifolds = frameArena.alloc<CollisionManifold>(halfKbs);
 
         kColWrapper.capacity = halfKbs;
         kColWrapper.count = 0;
     };
 
+    void Handler::addSensorPair(BodyRef const &sensor, BodyRef const &other) {
+        if (newSensorPairs.count == newSensorPairs.capacity && fixedMemory()) {
+            dropOverflow();
+            return;
+        }
+
+        addPair(resource, newSensorPairs, sensor, other);
+    };
+
+    void Handler::updateSensorEvents() {
+        // ? Match each overlap from this step against those from the previous step.
+        // ? Matched overlaps are stays, unmatched ones are enters, and overlaps from the previous step that were not matched are exits.
+        // ? Events are generated in update order so the results do not depend on where the bodies live in memory.
+
+        if (sensorPairs.count || newSensorPairs.count) {
+            buildPairTable(resource, sensorTable, sensorPairs);
+
+            int required = sensorEvents.count + sensorPairs.count + newSensorPairs.count;
+            if (!fixedMemory()) { reserveEvents(resource, sensorEvents, required); }
+
+            // events that do not fit are dropped, but the pairs are still diffed so the next step is unaffected
+            auto addEvent = [this](SensorEvent const &event) {
+                if (sensorEvents.count < sensorEvents.capacity) { sensorEvents.events[sensorEvents.count++] = event; }
+                else { dropOverflow(); }
+            };
+
+            for (int i = 0; i < newSensorPairs.count; ++i) {
+                int prev = findPair(sensorTable, sensorPairs, newSensorPairs.first[i].body, newSensorPairs.second[i].body);
+                SensorEventType type = SENSOR_ENTER;
+
+                if (prev != -1) {
+                    sensorTable.matched[prev] = 1;
+                    type = SENSOR_STAY;
+                }
+
+                addEvent({newSensorPairs.first[i], newSensorPairs.second[i], type});
+            }
+
+            for (int i = 0; i < sensorPairs.count; ++i) {
+                if (!sensorTable.matched[i]) { addEvent({sensorPairs.first[i], sensorPairs.second[i], SENSOR_EXIT}); }
+            }
+        }
+
+        // the current step's overlaps become the previous step's
+        BodyPairs temp = sensorPairs;
+        sensorPairs = newSensorPairs;
+        newSensorPairs = temp;
+        newSensorPairs.count = 0;
+    };
+
+    void Handler::addRemovedSensorEvents() {
+        if (!removedSensorPairs.count) { return; }
+
+        if (!fixedMemory()) { reserveEvents(resource, sensorEvents, sensorEvents.count + removedSensorPairs.count); }
+
+        for (int i = 0; i < removedSensorPairs.count; ++i) {
+            if (sensorEvents.count < sensorEvents.capacity) {
+                sensorEvents.events[sensorEvents.count++] = {removedSensorPairs.first[i], removedSensorPairs.second[i], SENSOR_EXIT};
+            } else { dropOverflow(); }
+        }
+
+        removedSensorPairs.count = 0;
+    };
+
+    void Handler::addContactEvent(BodyRef const &body1, BodyRef const &body2, CollisionManifold const &manifold) {
+        if (!manifold.numPoints) { return; } // speculative contacts are not touching yet
+
+        int prev = findPair(contactTable, contactPairs, body1.body, body2.body);
+        ContactEventType type = CONTACT_BEGIN;
+
+        if (prev != -1) {
+            contactTable.matched[prev] = 1;
+            type = CONTACT_PERSIST;
+        }
+
+        contactEvents->push({body1, body2, manifold.normal, manifold.pDist, type});
+
+        // a contact that is not remembered begins again next step
+        if (newContactPairs.count == newContactPairs.capacity && fixedMemory()) {
+            dropOverflow();
+            return;
+        }
+
+        addPair(resource, newContactPairs, body1, body2);
+    };
+
+    void Handler::updateContactEvents() {
+        // ? Same approach as the sensor events. The pairs are ordered so the normal points towards body2.
+
+        buildPairTable(resource, contactTable, contactPairs);
+
+        for (int i = 0; i < colWrapper.count; ++i) {
+            addContactEvent({colWrapper.bodies1[i], RIGID_BODY}, {colWrapper.bodies2[i], RIGID_BODY}, colWrapper.manifolds[i]);
+        }
+
+        for (int i = 0; i < staticColWrapper.count; ++i) {
+            addContactEvent({staticColWrapper.sbs[i], STATIC_BODY}, {staticColWrapper.rbs[i], RIGID_BODY}, staticColWrapper.manifolds[i]);
+        }
+
+        for (int i = 0; i < rkColWrapper.count; ++i) {
+            addContactEvent({rkColWrapper.kbs[i], KINEMATIC_BODY}, {rkColWrapper.rbs[i], RIGID_BODY}, rkColWrapper.manifolds[i]);
+        }
+
+        for (int i = 0; i < skColWrapper.count; ++i) {
+            addContactEvent({skColWrapper.sbs[i], STATIC_BODY}, {skColWrapper.kbs[i], KINEMATIC_BODY}, skColWrapper.manifolds[i]);
+        }
+
+        for (int i = 0; i < kColWrapper.count; ++i) {
+            addContactEvent({kColWrapper.kb1s[i], KINEMATIC_BODY}, {kColWrapper.kb2s[i], KINEMATIC_BODY}, kColWrapper.manifolds[i]);
+        }
+
+        // ? Pairs that were skipped by level of detail were not collided this step, so they keep touching without an event
+        // ?  until one of their rigid bodies is stepped again instead of ending now and beginning again on the next stepped tick.
+        if (lod.skippedCount) { std::sort(lod.skipped, lod.skipped + lod.skippedCount, std::less<RigidBody2D*>()); }
+
+        for (int i = 0; i < contactPairs.count; ++i) {
+            if (contactTable.matched[i]) { continue; }
+
+            if (lod.skippedCount && isContactSkipped(contactPairs.first[i], contactPairs.second[i])) {
+                if (newContactPairs.count == newContactPairs.capacity && fixedMemory()) {
+                    dropOverflow();
+                    continue;
+                }
+
+                addPair(resource, newContactPairs, contactPairs.first[i], contactPairs.second[i]);
+                continue;
+            }
+
+            contactEvents->push({contactPairs.first[i], contactPairs.second[i], ZMath::Vec2D(), 0.0f, CONTACT_END});
+        }
+
+        // the whole step becomes visible to the consumer at once
+        contactEvents->publish();
+
+        BodyPairs temp = contactPairs;
+        contactPairs = newContactPairs;
+        newContactPairs = temp;
+        newContactPairs.count = 0;
+    };
+
+    bool Handler::isContactSkipped(BodyRef const &body1, BodyRef const &body2) const {
+        // ? Static and kinematic bodies are collided every step, so only pairs with a rigid body can be skipped,
+        // ?  and only when none of their rigid bodies were stepped.
+        if (body1.type != RIGID_BODY && body2.type != RIGID_BODY) { return 0; }
+
+        RigidBody2D** end = lod.skipped + lod.skippedCount;
+        std::less<RigidBody2D*> less;
+
+        if (body1.type == RIGID_BODY && !std::binary_search(lod.skipped, end, (RigidBody2D*) body1.body, less)) { return 0; }
+        if (body2.type == RIGID_BODY && !std::binary_search(lod.skipped, end, (RigidBody2D*) body2.body, less)) { return 0; }
+
+        return 1;
+    };
+
+    void Handler::removeBodyPairs(void* body) { removeBodyPairsIf([body](void* other) { return other == body; }); };
+
+    template <typename F>
+    void Handler::removeBodyPairsIf(F const &removed) {
+        // ? The overlaps end now, but are reported by the next update so they arrive with the rest of the sensor events.
+        // ? Nothing is matched against them, so a new body reusing the removed one's memory cannot pick them up.
+        for (int i = 0; i < sensorPairs.count; ++i) {
+            if (!removed(sensorPairs.first[i].body) && !removed(sensorPairs.second[i].body)) { continue; }
+
+            if (removedSensorPairs.count == removedSensorPairs.capacity && fixedMemory()) {
+                dropOverflow();
+                continue;
+            }
+
+            addPair(resource, removedSensorPairs, sensorPairs.first[i], sensorPairs.second[i]);
+        }
+
+        removePairs(sensorPairs, removed);
+        if (contactEvents) { removePairs(contactPairs, removed); }
+
+        int count = 0;
+
+        for (int i = 0; i < sensorEvents.count; ++i) {
+            if (removed(sensorEvents.events[i].sensor.body) || removed(sensorEvents.events[i].other.body)) { continue; }
+            sensorEvents.events[count++] = sensorEvents.events[i];
+        }
+
+        sensorEvents.count = count;
+
+        if (observers.capacity) {
+            // ? Only clear the body out of the visible pairs so each observer's range of pairs stays where it is.
+            // ? Cleared pairs never match anything and do not generate events.
+            for (int i = 0; i < visiblePairs.count; ++i) {
+                if (removed(visiblePairs.first[i].body)) { visiblePairs.first[i].body = nullptr; }
+            }
+
+            count = 0;
+
+            for (int i = 0; i < visibilityEvents.count; ++i) {
+                if (removed(visibilityEvents.events[i].body.body)) { continue; }
+                visibilityEvents.events[count++] = visibilityEvents.events[i];
+            }
+
+            visibilityEvents.count = count;
+        }
+    };
+
     // * ===================================
     // * Constructors, Destructors, Etc.
     // * ===================================
@@ -293,54 +681,59 @@ namespace Zeta {
         * @param g (Vec3D) The force applied by gravity. Default of <0, 0, -9.8f>.
         * @param timeStep (float) The amount of time in seconds that must pass before the handler updates physics.
         *    Default speed of 60FPS. Anything above 60FPS is not recommended as it can cause lag in lower end hardware.
+        * @param resource Where the bodies and internal arrays are allocated from. Default of nullptr uses new and delete.
         */
-    Handler::Handler(ZMath::Vec2D const &g, float timeStep) : g(g), updateStep(timeStep) {
+    Handler::Handler(ZMath::Vec2D const &g, float timeStep, std::pmr::memory_resource* resource)
+        : frameArena(resource), resource(resource), updateStep(timeStep), g(g) {
+
         if (updateStep < FPS_60) { updateStep = FPS_60; } // hard cap at 60 FPS
 
+        staticTree.resource = resource;
+        dynamicTree.resource = resource;
+
         // * Bodies
-        rbs.rigidBodies = new RigidBody2D*[startingSlots];
+        rbs.rigidBodies = allocArray<RigidBody2D*>(resource, startingSlots);
         rbs.capacity = startingSlots;
         rbs.count = 0;
 
-        sbs.staticBodies = new StaticBody2D*[startingSlots];
+        sbs.staticBodies = allocArray<StaticBody2D*>(resource, startingSlots);
         sbs.capacity = startingSlots;
         sbs.count = 0;
 
-        kbs.kinematicBodies = new KinematicBody2D*[kStartingSlots];
+        kbs.kinematicBodies = allocArray<KinematicBody2D*>(resource, kStartingSlots);
         kbs.capacity = kStartingSlots;
         kbs.count = 0;
 
 
         // * Collisions
-        colWrapper.bodies1 = new RigidBody2D*[halfStartingSlots];
-        colWrapper.bodies2 = new RigidBody2D*[halfStartingSlots];
-        colWrapper.manifolds = new CollisionManifold[halfStartingSlots];
-        colWrapper.capacity = halfStartingSlots;
-        colWrapper.count = 0;
-
-        staticColWrapper.sbs = new StaticBody2D*[halfStartingSlots];
-        staticColWrapper.rbs = new RigidBody2D*[halfStartingSlots];
-        staticColWrapper.manifolds = new CollisionManifold[halfStartingSlots];
-        staticColWrapper.capacity = halfStartingSlots;
-        staticColWrapper.count = 0;
-
-        rkColWrapper.rbs = new RigidBody2D*[kHalfStartingSlots];
-        rkColWrapper.kbs = new KinematicBody2D*[kHalfStartingSlots];
-        rkColWrapper.manifolds = new CollisionManifold[kHalfStartingSlots];
-        rkColWrapper.capacity = kHalfStartingSlots;
-        rkColWrapper.count = 0;
-
-        skColWrapper.sbs = new StaticBody2D*[kHalfStartingSlots];
-        skColWrapper.kbs = new KinematicBody2D*[kHalfStartingSlots];
-        skColWrapper.manifolds = new CollisionManifold[kHalfStartingSlots];
-        skColWrapper.capacity = kHalfStartingSlots;
-        skColWrapper.count = 0;
-
-        kColWrapper.kb1s = new KinematicBody2D*[kHalfStartingSlots];
-        kColWrapper.kb2s = new KinematicBody2D*[kHalfStartingSlots];
-        kColWrapper.manifolds = new CollisionManifold[kHalfStartingSlots];
-        kColWrapper.capacity = kHalfStartingSlots;
-        kColWrapper.count = 0;
+        frameArena.reserve(startingArenaBytes);
+        clearCollisions();
+
+
+        // * Sensors
+        sensorPairs.first = allocArray<BodyRef>(resource, halfStartingSlots);
+        sensorPairs.second = allocArray<BodyRef>(resource, halfStartingSlots);
+        sensorPairs.capacity = halfStartingSlots;
+        sensorPairs.count = 0;
+
+        newSensorPairs.first = allocArray<BodyRef>(resource, halfStartingSlots);
+        newSensorPairs.second = allocArray<BodyRef>(resource, halfStartingSlots);
+        newSensorPairs.capacity = halfStartingSlots;
+        newSensorPairs.count = 0;
+
+        removedSensorPairs.first = allocArray<BodyRef>(resource, halfStartingSlots);
+        removedSensorPairs.second = allocArray<BodyRef>(resource, halfStartingSlots);
+        removedSensorPairs.capacity = halfStartingSlots;
+        removedSensorPairs.count = 0;
+
+        sensorTable.slots = allocArray<int>(resource, startingSlots);
+        sensorTable.slotCapacity = startingSlots;
+        sensorTable.matched = allocArray<bool>(resource, halfStartingSlots);
+        sensorTable.capacity = halfStartingSlots;
+
+        sensorEvents.events = allocArray<SensorEvent>(resource, startingSlots);
+        sensorEvents.capacity = startingSlots;
+        sensorEvents.count = 0;
     };
 
     // Do not allow for construction from an existing physics handler.
@@ -356,57 +749,89 @@ namespace Zeta {
         if (rbs.rigidBodies) {
             // * Bodies
 
-            for (int i = 0; i < rbs.count; ++i) { delete rbs.rigidBodies[i]; }
-            delete[] rbs.rigidBodies;
-
-            for (int i = 0; i < sbs.count; ++i) { delete sbs.staticBodies[i]; }
-            delete[] sbs.staticBodies;
-
-            for (int i = 0; i < kbs.count; ++i) { delete kbs.kinematicBodies[i]; }
-            delete[] kbs.kinematicBodies;
-
-
-            // * Collisions
-
-            for (int i = 0; i < colWrapper.count; ++i) {
-                delete colWrapper.bodies1[i];
-                delete colWrapper.bodies2[i];
+            // pooled bodies are freed along with their pool
+            for (int i = 0; i < rbs.count; ++i) {
+                if (findRigidBodyPool(rbs.rigidBodies[i]) < 0) { deleteObject(resource, rbs.rigidBodies[i]); }
             }
 
-            // ? Note: we do not need to delete each RigidBody pointer in bodies1 and bodies2 as the main rigidBodies list
-            // ?       is guarenteed to contain those same pointers.
-            delete[] colWrapper.bodies1;
-            delete[] colWrapper.bodies2;
-
-            // ? We do not need to check for nullptr for contactPoints as if colWrapper.count > 0, it is guarenteed manifolds[i].contactPoints != nullptr.
-            for (int i = 0; i < colWrapper.count; ++i) { delete[] colWrapper.manifolds[i].contactPoints; }
-            delete[] colWrapper.manifolds;
-
-            // * Same thing but for the static collisions
-            delete[] staticColWrapper.sbs;
-            delete[] staticColWrapper.rbs;
-
-            for (int i = 0; i < staticColWrapper.count; ++i) { delete[] staticColWrapper.manifolds[i].contactPoints; }
-            delete[] colWrapper.manifolds;
+            freeArray(resource, rbs.rigidBodies, rbs.capacity);
 
-            // * Same stuff but for kinematic body collisions
-            delete[] rkColWrapper.kbs;
-            delete[] rkColWrapper.rbs;
+            for (int i = 0; i < rigidPools.count; ++i) {
+                RigidBodyPool &pool = rigidPools.pools[i];
 
-            for (int i = 0; i < rkColWrapper.count; ++i) { delete[] rkColWrapper.manifolds[i].contactPoints; }
-            delete[] rkColWrapper.manifolds;
+                freeArray(resource, pool.bodies, pool.capacity);
+                freeArray(resource, pool.indices, pool.capacity);
+                freeArray(resource, pool.freeSlots, pool.capacity);
+            }
 
-            delete[] skColWrapper.kbs;
-            delete[] skColWrapper.sbs;
+            freeArray(resource, rigidPools.pools, rigidPools.capacity);
 
-            for (int i = 0; i < skColWrapper.count; ++i) { delete[] skColWrapper.manifolds[i].contactPoints; }
-            delete[] skColWrapper.manifolds;
+            // static bodies loaded from a scene are freed when the scene is unmapped
+            for (int i = 0; i < sbs.count; ++i) {
+                if (!scene || !scene->contains(sbs.staticBodies[i])) { deleteObject(resource, sbs.staticBodies[i]); }
+            }
 
-            delete[] kColWrapper.kb1s;
-            delete[] kColWrapper.kb2s;
+            freeArray(resource, sbs.staticBodies, sbs.capacity);
+            deleteObject(resource, scene);
+
+            for (int i = 0; i < kbs.count; ++i) { deleteObject(resource, kbs.kinematicBodies[i]); }
+            freeArray(resource, kbs.kinematicBodies, kbs.capacity);
+
+
+            // ? The collision wrappers and their contact points are freed along with the frame arena.
+
+
+            // * Sensors
+
+            freeArray(resource, sensorPairs.first, sensorPairs.capacity);
+            freeArray(resource, sensorPairs.second, sensorPairs.capacity);
+            freeArray(resource, newSensorPairs.first, newSensorPairs.capacity);
+            freeArray(resource, newSensorPairs.second, newSensorPairs.capacity);
+            freeArray(resource, removedSensorPairs.first, removedSensorPairs.capacity);
+            freeArray(resource, removedSensorPairs.second, removedSensorPairs.capacity);
+            freeArray(resource, sensorTable.slots, sensorTable.slotCapacity);
+            freeArray(resource, sensorTable.matched, sensorTable.capacity);
+            freeArray(resource, sensorEvents.events, sensorEvents.capacity);
+
+            freeArray(resource, interpolation.prev, interpolation.capacity);
+            freeArray(resource, interpolation.curr, interpolation.capacity);
+
+            freeArray(resource, activeRegions.mins, activeRegions.capacity);
+            freeArray(resource, activeRegions.maxes, activeRegions.capacity);
+            freeArray(resource, lod.intervals, lod.capacity);
+            freeArray(resource, lod.stepped, lod.capacity);
+            freeArray(resource, lod.skipped, lod.capacity);
+            freeArray(resource, morton.entries, morton.capacity);
+
+            if (observers.capacity) {
+                freeArray(resource, observers.mins, observers.capacity);
+                freeArray(resource, observers.maxes, observers.capacity);
+                freeArray(resource, observers.start, observers.capacity);
+                freeArray(resource, observers.visible, observers.capacity);
+                freeArray(resource, observers.active, observers.capacity);
+                freeArray(resource, observers.moved, observers.capacity);
+                freeArray(resource, observedBounds.mins, observedBounds.capacity);
+                freeArray(resource, observedBounds.maxes, observedBounds.capacity);
+                freeArray(resource, observedBounds.changed, observedBounds.capacity);
+
+                freeArray(resource, visiblePairs.first, visiblePairs.capacity);
+                freeArray(resource, visiblePairs.second, visiblePairs.capacity);
+                freeArray(resource, newVisiblePairs.first, newVisiblePairs.capacity);
+                freeArray(resource, newVisiblePairs.second, newVisiblePairs.capacity);
+                freeArray(resource, visibleTable.slots, visibleTable.slotCapacity);
+                freeArray(resource, visibleTable.matched, visibleTable.capacity);
+                freeArray(resource, visibilityEvents.events, visibilityEvents.capacity);
+            }
 
-            for (int i = 0; i < kColWrapper.count; ++i) { delete[] kColWrapper.manifolds[i].contactPoints; }
-            delete[] kColWrapper.manifolds;
+            if (contactEvents) {
+                freeArray(resource, contactPairs.first, contactPairs.capacity);
+                freeArray(resource, contactPairs.second, contactPairs.capacity);
+                freeArray(resource, newContactPairs.first, newContactPairs.capacity);
+                freeArray(resource, newContactPairs.second, newContactPairs.capacity);
+                freeArray(resource, contactTable.slots, contactTable.slotCapacity);
+                freeArray(resource, contactTable.matched, contactTable.capacity);
+                deleteObject(resource, contactEvents);
+            }
         }
     };
 
@@ -418,92 +843,324 @@ namespace Zeta {
     // Add a rigid body to the list of rigid bodies to be updated.
     void Handler::addRigidBody(RigidBody2D* rb) {
         if (rbs.count == rbs.capacity) {
+            int oldCapacity = rbs.capacity;
+
             rbs.capacity *= 2;
-            RigidBody2D** temp = new RigidBody2D*[rbs.capacity];
+            RigidBody2D** temp = allocArray<RigidBody2D*>(resource, rbs.capacity);
 
             for (int i = 0; i < rbs.count; ++i) { temp[i] = rbs.rigidBodies[i]; }
 
-            delete[] rbs.rigidBodies;
+            freeArray(resource, rbs.rigidBodies, oldCapacity);
             rbs.rigidBodies = temp;
         }
 
+        rb->updateBounds();
+        rb->lodPhase = rbs.count;
+
         rbs.rigidBodies[rbs.count++] = rb;
+        if (recorder) { recorder->recordAdd(RIGID_BODY, rb); }
+
+        dynamicTree.reserve(rbs.count + kbs.count);
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+    };
+
+    void Handler::reserveRigidBodies(int n) {
+        if (n > rbs.capacity) {
+            int oldCapacity = rbs.capacity;
+
+            do { rbs.capacity *= 2; } while (n > rbs.capacity);
+            RigidBody2D** temp = allocArray<RigidBody2D*>(resource, rbs.capacity);
+
+            for (int i = 0; i < rbs.count; ++i) { temp[i] = rbs.rigidBodies[i]; }
+
+            freeArray(resource, rbs.rigidBodies, oldCapacity);
+            rbs.rigidBodies = temp;
+        }
+
+        // the tree's items are kept, but its nodes have to be rebuilt if it grows
+        if (n + kbs.count > dynamicTree.capacity) {
+            dynamicTree.reserve(n + kbs.count);
+            dynamicTreeDirty = 1;
+        }
     };
 
     // Add a list of rigid bodies to the handler.
     void Handler::addRigidBodies(RigidBody2D** rbs, int size) {
-        if (this->rbs.count + size > this->rbs.capacity) {
-            do { this->rbs.capacity *= 2; } while (this->rbs.count + size > this->rbs.capacity);
-            RigidBody2D** temp = new RigidBody2D*[this->rbs.capacity];
-        
-            for (int i = 0; i < this->rbs.count; ++i) { temp[i] = this->rbs.rigidBodies[i]; }
+        reserveRigidBodies(this->rbs.count + size);
+
+
+        for (int i = 0; i < size; ++i) {
+            rbs[i]->updateBounds();
+            rbs[i]->lodPhase = this->rbs.count;
+            this->rbs.rigidBodies[this->rbs.count++] = rbs[i];
+        }
+        for (int i = 0; i < size && recorder; ++i) { recorder->recordAdd(RIGID_BODY, rbs[i]); }
+
+        dynamicTree.reserve(this->rbs.count + kbs.count);
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+    };
+
+    RigidBody2D* Handler::createRigidBody(ZMath::Vec2D const &pos, float mass, float cor, float linearDamping, RigidBodyCollider colliderType, void* collider) {
+        RigidBody2D* rb = newObject<RigidBody2D>(resource, pos, mass, cor, linearDamping, colliderType, collider);
+        addRigidBody(rb);
+
+        return rb;
+    };
+
+    int Handler::findRigidBody(RigidBody2D const* rb) const {
+        int pool = findRigidBodyPool(rb);
+        if (pool >= 0) { return rigidPools.pools[pool].indices[rb - rigidPools.pools[pool].bodies]; }
+
+        for (int i = rbs.count - 1; i >= 0; --i) {
+            if (rbs.rigidBodies[i] == rb) { return i; }
+        }
+
+        return -1;
+    };
+
+    void Handler::freeRigidBody(RigidBody2D* rb) {
+        int pool = findRigidBodyPool(rb);
 
-            delete[] this->rbs.rigidBodies;
-            this->rbs.rigidBodies = temp;
+        if (pool < 0) {
+            deleteObject(resource, rb);
+            return;
         }
 
+        RigidBodyPool &p = rigidPools.pools[pool];
+        int slot = rb - p.bodies;
 
-        for (int i = 0; i < size; ++i) { this->rbs.rigidBodies[this->rbs.count++] = rbs[i]; }
+        p.indices[slot] = -1;
+        p.freeSlots[p.freeCount++] = slot;
     };
 
     // Remove a rigid body from the handler.
     // 1 = rigid body was found and removed. 0 = It was not found.
-    // rb will be deleted if the rigid body was found.
+    // rb will be freed (or returned to its pool) if the rigid body was found.
     bool Handler::removeRigidBody(RigidBody2D* rb) {
-        for (int i = rbs.count - 1; i >= 0; --i) {
-            if (rbs.rigidBodies[i] == rb) {
-                delete rb;
-                for (int j = i; i < rbs.count - 1; ++j) { rbs.rigidBodies[j] = rbs.rigidBodies[j + 1]; }
-                rbs.count--;
-                return 1;
-            }
+        int i = findRigidBody(rb);
+        if (i < 0) { return 0; }
+
+        if (recorder) { recorder->recordRemove(RIGID_BODY, i); }
+        removeBodyPairs(rb);
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+        freeRigidBody(rb);
+
+        for (int j = i; j < rbs.count - 1; ++j) {
+            rbs.rigidBodies[j] = rbs.rigidBodies[j + 1];
+            setRigidBodyIndex(rbs.rigidBodies[j], j);
         }
 
-        return 0;
+        rbs.count--;
+        return 1;
     };
 
 
     // * ============================
-    // * StaticBody List Functions
+    // * RigidBody Pools
     // * ============================
 
-    // Add a static body to the handler.
-    void Handler::addStaticBody(StaticBody2D* sb) {
-        if (sbs.count == sbs.capacity) {
-            sbs.capacity *= 2;
-            StaticBody2D** temp = new StaticBody2D*[sbs.capacity];
+    int Handler::createRigidBodyPool(int capacity) {
+        if (rigidPools.count == rigidPools.capacity) {
+            int oldCapacity = rigidPools.capacity;
+            rigidPools.capacity = oldCapacity ? 2*oldCapacity : 2;
 
-            for (int i = 0; i < sbs.count; ++i) { temp[i] = sbs.staticBodies[i]; }
+            RigidBodyPool* temp = allocArray<RigidBodyPool>(resource, rigidPools.capacity);
+            for (int i = 0; i < rigidPools.count; ++i) { temp[i] = rigidPools.pools[i]; }
 
-            delete[] sbs.staticBodies;
-            sbs.staticBodies = temp;
+            freeArray(resource, rigidPools.pools, oldCapacity);
+            rigidPools.pools = temp;
         }
 
-        sbs.staticBodies[sbs.count++] = sb;
-    };
+        RigidBodyPool &pool = rigidPools.pools[rigidPools.count];
 
-    // Add a list of static bodies to the handler.
-    void Handler::addStaticBodies(StaticBody2D** sbs, int size) {
-        if (this->sbs.count + size > this->sbs.capacity) {
-            do { this->sbs.capacity *= 2; } while(this->sbs.count + size > this->sbs.capacity);
-            StaticBody2D** temp = new StaticBody2D*[this->sbs.capacity];
+        pool.bodies = allocArray<RigidBody2D>(resource, capacity);
+        pool.indices = allocArray<int>(resource, capacity);
+        pool.freeSlots = allocArray<int>(resource, capacity);
+        pool.capacity = capacity;
+        pool.freeCount = capacity;
 
-            for (int i = 0; i < this->sbs.count; ++i) { temp[i] = this->sbs.staticBodies[i]; }
+        // slots are handed out in order
+        for (int i = 0; i < capacity; ++i) {
+            pool.indices[i] = -1;
+            pool.freeSlots[i] = capacity - 1 - i;
+        }
 
-            delete[] this->sbs.staticBodies;
-            this->sbs.staticBodies = temp;
+        // ? Reserving room for every body in the pool keeps spawning from growing the handler's arrays.
+        reserveRigidBodies(rbs.count + capacity);
+
+        return rigidPools.count++;
+    };
+
+    int Handler::findRigidBodyPool(RigidBody2D const* rb) const {
+        for (int i = 0; i < rigidPools.count; ++i) {
+            RigidBodyPool const &pool = rigidPools.pools[i];
+            if (rb >= pool.bodies && rb < pool.bodies + pool.capacity) { return i; }
         }
 
-        for (int i = 0; i < size; ++i) { this->sbs.staticBodies[this->sbs.count++] = sbs[i]; }
+        return -1;
     };
 
-    // Remove a static body from the handler.
+    void Handler::setRigidBodyIndex(RigidBody2D const* rb, int i) {
+        if (!rigidPools.count) { return; }
+
+        int pool = findRigidBodyPool(rb);
+        if (pool >= 0) { rigidPools.pools[pool].indices[rb - rigidPools.pools[pool].bodies] = i; }
+    };
+
+    RigidBody2D* Handler::spawnRigidBody(int pool, RigidBody2D const &body) {
+        RigidBodyPool &p = rigidPools.pools[pool];
+        if (!p.freeCount) { return nullptr; }
+
+        int slot = p.freeSlots[--p.freeCount];
+        RigidBody2D* rb = p.bodies + slot;
+
+        *rb = body;
+        p.indices[slot] = rbs.count;
+        addRigidBody(rb);
+
+        return rb;
+    };
+
+    int Handler::spawnRigidBodies(int pool, RigidBody2D const* bodies, int count, RigidBody2D** spawned) {
+        int n = MIN(count, rigidPools.pools[pool].freeCount);
+        reserveRigidBodies(rbs.count + n);
+
+        for (int i = 0; i < n; ++i) {
+            RigidBody2D* rb = spawnRigidBody(pool, bodies[i]);
+            if (spawned) { spawned[i] = rb; }
+        }
+
+        return n;
+    };
+
+    void Handler::despawnRigidBodyAt(int i) {
+        RigidBody2D* rb = rbs.rigidBodies[i];
+        if (recorder) { recorder->recordDespawn(i); }
+
+        rbs.rigidBodies[i] = rbs.rigidBodies[--rbs.count];
+        if (i < rbs.count) { setRigidBodyIndex(rbs.rigidBodies[i], i); }
+
+        freeRigidBody(rb);
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+    };
+
+    bool Handler::despawnRigidBody(RigidBody2D* rb) {
+        int i = findRigidBody(rb);
+        if (i < 0) { return 0; }
+
+        removeBodyPairs(rb);
+        despawnRigidBodyAt(i);
+
+        return 1;
+    };
+
+    int Handler::despawnRigidBodies(RigidBody2D* const* rbs, int count) {
+        // ? The despawned bodies are sorted so their pairs can be forgotten in a single pass instead of one pass per body.
+        // ? The list only lives until the pairs are gone, so it comes from the frame arena.
+        void** removed = frameArena.alloc<void*>(count);
+        int n = 0;
+
+        for (int i = 0; i < count; ++i) {
+            int index = findRigidBody(rbs[i]);
+            if (index < 0) { continue; }
+
+            removed[n++] = rbs[i];
+            despawnRigidBodyAt(index);
+        }
+
+        if (n) {
+            std::sort(removed, removed + n, std::less<void*>());
+            removeBodyPairsIf([removed, n](void* body) { return std::binary_search(removed, removed + n, body, std::less<void*>()); });
+        }
+
+        clearCollisions(); // hand the list back to the frame arena so the next step has all of it
+
+        return n;
+    };
+
+
+    // * ============================
+    // * StaticBody List Functions
+    // * ============================
+
+    // Add a static body to the handler.
+    void Handler::addStaticBody(StaticBody2D* sb) {
+        if (sbs.count == sbs.capacity) {
+            int oldCapacity = sbs.capacity;
+
+            sbs.capacity *= 2;
+            StaticBody2D** temp = allocArray<StaticBody2D*>(resource, sbs.capacity);
+
+            for (int i = 0; i < sbs.count; ++i) { temp[i] = sbs.staticBodies[i]; }
+
+            freeArray(resource, sbs.staticBodies, oldCapacity);
+            sbs.staticBodies = temp;
+        }
+
+        sb->updateBounds();
+
+        sbs.staticBodies[sbs.count++] = sb;
+        if (recorder) { recorder->recordAdd(STATIC_BODY, sb); }
+
+        staticTree.reserve(sbs.count);
+        staticTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+    };
+
+    // Add a list of static bodies to the handler.
+    void Handler::addStaticBodies(StaticBody2D** sbs, int size) {
+        if (this->sbs.count + size > this->sbs.capacity) {
+            int oldCapacity = this->sbs.capacity;
+
+            do { this->sbs.capacity *= 2; } while(this->sbs.count + size > this->sbs.capacity);
+            StaticBody2D** temp = allocArray<StaticBody2D*>(resource, this->sbs.capacity);
+
+            for (int i = 0; i < this->sbs.count; ++i) { temp[i] = this->sbs.staticBodies[i]; }
+
+            freeArray(resource, this->sbs.staticBodies, oldCapacity);
+            this->sbs.staticBodies = temp;
+        }
+
+        for (int i = 0; i < size; ++i) {
+            sbs[i]->updateBounds();
+            this->sbs.staticBodies[this->sbs.count++] = sbs[i];
+        }
+        for (int i = 0; i < size && recorder; ++i) { recorder->recordAdd(STATIC_BODY, sbs[i]); }
+
+        staticTree.reserve(this->sbs.count);
+        staticTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+    };
+
+    StaticBody2D* Handler::createStaticBody(ZMath::Vec2D const &pos, StaticBodyCollider colliderType, void* collider) {
+        StaticBody2D* sb = newObject<StaticBody2D>(resource, pos, colliderType, collider);
+        addStaticBody(sb);
+
+        return sb;
+    };
+
+    // Remove a static body from the handler.
     // 1 = static body was found and removed. 0 = It was not found.
-    // sb will be deleted if the static body was found.
+    // sb will be freed if the static body was found.
     bool Handler::removeStaticBody(StaticBody2D* sb) {
         for (int i = sbs.count - 1; i >= 0; --i) {
             if (sbs.staticBodies[i] == sb) {
-                delete sb;
+                if (recorder) { recorder->recordRemove(STATIC_BODY, i); }
+                removeBodyPairs(sb);
+                staticTreeDirty = 1;
+                ++bodyIndexGeneration;
+                ++bodySetGeneration;
+                if (!scene || !scene->contains(sb)) { deleteObject(resource, sb); }
                 for (int j = i; j < sbs.count - 1; ++j) { sbs.staticBodies[j] = sbs.staticBodies[j + 1]; }
                 sbs.count--;
                 return 1;
@@ -521,40 +1178,73 @@ namespace Zeta {
     // Add a kinematic body to the handler.
     void Handler::addKinematicBody(KinematicBody2D* kb) {
         if (kbs.count == kbs.capacity) {
+            int oldCapacity = kbs.capacity;
+
             kbs.capacity *= 2;
-            KinematicBody2D** temp = new KinematicBody2D*[kbs.capacity];
+            KinematicBody2D** temp = allocArray<KinematicBody2D*>(resource, kbs.capacity);
 
             for (int i = 0; i < kbs.count; ++i) { temp[i] = kbs.kinematicBodies[i]; }
 
-            delete[] kbs.kinematicBodies;
+            freeArray(resource, kbs.kinematicBodies, oldCapacity);
             kbs.kinematicBodies = temp;
         }
 
-        kbs.kinematicBodies[sbs.count++] = kb;
+        kb->updateBounds();
+
+        kbs.kinematicBodies[kbs.count++] = kb;
+        if (recorder) { recorder->recordAdd(KINEMATIC_BODY, kb); }
+
+        dynamicTree.reserve(rbs.count + kbs.count);
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
     };
 
     // Add a list of kinematic bodies to the handler.
     void Handler::addKinematicBodies(KinematicBody2D** kbs, int size) {
         if (this->kbs.count + size > this->kbs.capacity) {
+            int oldCapacity = this->kbs.capacity;
+
             do { this->kbs.capacity *= 2; } while(this->kbs.count + size > this->kbs.capacity);
-            KinematicBody2D** temp = new KinematicBody2D*[this->kbs.capacity];
+            KinematicBody2D** temp = allocArray<KinematicBody2D*>(resource, this->kbs.capacity);
 
             for (int i = 0; i < this->kbs.count; ++i) { temp[i] = this->kbs.kinematicBodies[i]; }
 
-            delete[] this->kbs.kinematicBodies;
+            freeArray(resource, this->kbs.kinematicBodies, oldCapacity);
             this->kbs.kinematicBodies = temp;
         }
 
-        for (int i = 0; i < size; ++i) { this->kbs.kinematicBodies[this->kbs.count++] = kbs[i]; }
+        for (int i = 0; i < size; ++i) {
+            kbs[i]->updateBounds();
+            this->kbs.kinematicBodies[this->kbs.count++] = kbs[i];
+        }
+        for (int i = 0; i < size && recorder; ++i) { recorder->recordAdd(KINEMATIC_BODY, kbs[i]); }
+
+        dynamicTree.reserve(rbs.count + this->kbs.count);
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+    };
+
+    KinematicBody2D* Handler::createKinematicBody(ZMath::Vec2D const &pos, KinematicBodyCollider colliderType, void* collider) {
+        KinematicBody2D* kb = newObject<KinematicBody2D>(resource, pos, colliderType, collider);
+        addKinematicBody(kb);
+
+        return kb;
     };
 
     // Remove a kinematic body from the handler.
     // 1 = kinematic body was found and removed. 0 = It was not found.
-    // kb will be deleted if the kinematic body was found.
+    // kb will be freed if the kinematic body was found.
     bool Handler::removeKinematicBody(KinematicBody2D* kb) {
         for (int i = kbs.count - 1; i >= 0; --i) {
             if (kbs.kinematicBodies[i] == kb) {
-                delete kb;
+                if (recorder) { recorder->recordRemove(KINEMATIC_BODY, i); }
+                removeBodyPairs(kb);
+                dynamicTreeDirty = 1;
+                ++bodyIndexGeneration;
+                ++bodySetGeneration;
+                deleteObject(resource, kb);
                 for (int j = i; j < kbs.count - 1; ++j) { kbs.kinematicBodies[j] = kbs.kinematicBodies[j + 1]; }
                 kbs.count--;
                 return 1;
@@ -565,6 +1255,384 @@ namespace Zeta {
     };
 
 
+    // * ==============================
+    // * Contact Event Functions
+    // * ==============================
+
+    void Handler::enableContactEvents(int capacity) {
+        if (contactEvents) {
+            deleteObject(resource, contactEvents);
+            contactEvents = newObject<ContactEventQueue>(resource, capacity, resource);
+            return;
+        }
+
+        contactEvents = newObject<ContactEventQueue>(resource, capacity, resource);
+
+        contactPairs.first = allocArray<BodyRef>(resource, startingSlots);
+        contactPairs.second = allocArray<BodyRef>(resource, startingSlots);
+        contactPairs.capacity = startingSlots;
+        contactPairs.count = 0;
+
+        newContactPairs.first = allocArray<BodyRef>(resource, startingSlots);
+        newContactPairs.second = allocArray<BodyRef>(resource, startingSlots);
+        newContactPairs.capacity = startingSlots;
+        newContactPairs.count = 0;
+
+        contactTable.slots = allocArray<int>(resource, 2*startingSlots);
+        contactTable.slotCapacity = 2*startingSlots;
+        contactTable.matched = allocArray<bool>(resource, startingSlots);
+        contactTable.capacity = startingSlots;
+
+        if (reservedContacts) {
+            reservePairs(resource, contactPairs, reservedContacts);
+            reservePairs(resource, newContactPairs, reservedContacts);
+            reservePairTable(resource, contactTable, reservedContacts);
+        }
+    };
+
+
+    // * ======================
+    // * Observers
+    // * ======================
+
+    // ? The visible pairs store each visible body in first and a key for the observer in second.
+    // ? Keys are small integers so they can never be mistaken for a body.
+    static inline void* observerKey(int observer) { return (void*) (uintptr_t) (observer + 1); };
+
+    int Handler::addObserver(AABB const &view) {
+        if (!observers.capacity) {
+            observers.mins = allocArray<ZMath::Vec2D>(resource, 4);
+            observers.maxes = allocArray<ZMath::Vec2D>(resource, 4);
+            observers.start = allocArray<int>(resource, 4);
+            observers.visible = allocArray<int>(resource, 4);
+            observers.active = allocArray<bool>(resource, 4);
+            observers.moved = allocArray<bool>(resource, 4);
+            observers.capacity = 4;
+
+            visiblePairs.first = allocArray<BodyRef>(resource, startingSlots);
+            visiblePairs.second = allocArray<BodyRef>(resource, startingSlots);
+            visiblePairs.capacity = startingSlots;
+            visiblePairs.count = 0;
+
+            newVisiblePairs.first = allocArray<BodyRef>(resource, startingSlots);
+            newVisiblePairs.second = allocArray<BodyRef>(resource, startingSlots);
+            newVisiblePairs.capacity = startingSlots;
+            newVisiblePairs.count = 0;
+
+            visibleTable.slots = allocArray<int>(resource, 2*startingSlots);
+            visibleTable.slotCapacity = 2*startingSlots;
+            visibleTable.matched = allocArray<bool>(resource, startingSlots);
+            visibleTable.capacity = startingSlots;
+
+            visibilityEvents.events = allocArray<VisibilityEvent>(resource, startingSlots);
+            visibilityEvents.capacity = startingSlots;
+        }
+
+        int observer = 0;
+        while (observer < observers.count && observers.active[observer]) { ++observer; }
+
+        if (observer == observers.capacity) {
+            int oldCapacity = observers.capacity;
+            observers.capacity *= 2;
+
+            ZMath::Vec2D* temp1 = allocArray<ZMath::Vec2D>(resource, observers.capacity);
+            ZMath::Vec2D* temp2 = allocArray<ZMath::Vec2D>(resource, observers.capacity);
+            int* temp3 = allocArray<int>(resource, observers.capacity);
+            int* temp4 = allocArray<int>(resource, observers.capacity);
+            bool* temp5 = allocArray<bool>(resource, observers.capacity);
+            bool* temp6 = allocArray<bool>(resource, observers.capacity);
+
+            for (int i = 0; i < observers.count; ++i) {
+                temp1[i] = observers.mins[i];
+                temp2[i] = observers.maxes[i];
+                temp3[i] = observers.start[i];
+                temp4[i] = observers.visible[i];
+                temp5[i] = observers.active[i];
+                temp6[i] = observers.moved[i];
+            }
+
+            freeArray(resource, observers.mins, oldCapacity);
+            freeArray(resource, observers.maxes, oldCapacity);
+            freeArray(resource, observers.start, oldCapacity);
+            freeArray(resource, observers.visible, oldCapacity);
+            freeArray(resource, observers.active, oldCapacity);
+            freeArray(resource, observers.moved, oldCapacity);
+
+            observers.mins = temp1;
+            observers.maxes = temp2;
+            observers.start = temp3;
+            observers.visible = temp4;
+            observers.active = temp5;
+            observers.moved = temp6;
+        }
+
+        if (observer == observers.count) { ++observers.count; }
+
+        observers.mins[observer] = view.getMin();
+        observers.maxes[observer] = view.getMax();
+        observers.start[observer] = 0;
+        observers.visible[observer] = 0;
+        observers.active[observer] = 1;
+        observers.moved[observer] = 1;
+
+        return observer;
+    };
+
+    void Handler::setObserverView(int observer, AABB const &view) {
+        observers.mins[observer] = view.getMin();
+        observers.maxes[observer] = view.getMax();
+        observers.moved[observer] = 1;
+    };
+
+    void Handler::removeObserver(int observer) {
+        // clear its pairs so an observer reusing the id does not inherit them
+        int end = observers.start[observer] + observers.visible[observer];
+        for (int i = observers.start[observer]; i < end; ++i) { visiblePairs.first[i].body = nullptr; }
+
+        observers.visible[observer] = 0;
+        observers.active[observer] = 0;
+
+        int count = 0;
+
+        for (int i = 0; i < visibilityEvents.count; ++i) {
+            if (visibilityEvents.events[i].observer == observer) { continue; }
+            visibilityEvents.events[count++] = visibilityEvents.events[i];
+        }
+
+        visibilityEvents.count = count;
+    };
+
+    int Handler::getVisibleBodies(int observer, BodyRef* bodies, int capacity) const {
+        int count = 0;
+        int end = observers.start[observer] + observers.visible[observer];
+
+        for (int i = observers.start[observer]; i < end && count < capacity; ++i) {
+            if (visiblePairs.first[i].body) { bodies[count++] = visiblePairs.first[i]; }
+        }
+
+        return count;
+    };
+
+    // Where a body's bounds are relative to a view.
+    enum ViewOverlap {
+        VIEW_OUTSIDE, // the bounds do not touch the view
+        VIEW_INSIDE, // the bounds are entirely inside the view
+        VIEW_CROSSING // the bounds cross one of the view's edges
+    };
+
+    static inline ViewOverlap findViewOverlap(ZMath::Vec2D const &min, ZMath::Vec2D const &max, ZMath::Vec2D const &viewMin, ZMath::Vec2D const &viewMax) {
+        if (min.x > viewMax.x || max.x < viewMin.x || min.y > viewMax.y || max.y < viewMin.y) { return VIEW_OUTSIDE; }
+        if (min.x >= viewMin.x && max.x <= viewMax.x && min.y >= viewMin.y && max.y <= viewMax.y) { return VIEW_INSIDE; }
+        return VIEW_CROSSING;
+    };
+
+    void Handler::addVisibilityEvent(VisibilityEvent const &event) {
+        if (visibilityEvents.count == visibilityEvents.capacity) {
+            if (fixedMemory()) {
+                dropOverflow();
+                return;
+            }
+
+            reserveEvents(resource, visibilityEvents, visibilityEvents.count + 1);
+        }
+
+        visibilityEvents.events[visibilityEvents.count++] = event;
+    };
+
+    void Handler::queryObserver(int observer) {
+        int start = newVisiblePairs.count;
+        AABB view(observers.mins[observer], observers.maxes[observer]);
+
+        // the queries stop once the pairs are full, so grow them and query again until the view fits
+        int count = query(staticTree, RIGID_AABB_COLLIDER, &view, newVisiblePairs.first, start, newVisiblePairs.capacity);
+        count = query(dynamicTree, RIGID_AABB_COLLIDER, &view, newVisiblePairs.first, count, newVisiblePairs.capacity);
+
+        while (count == newVisiblePairs.capacity && !fixedMemory()) {
+            reservePairs(resource, newVisiblePairs, newVisiblePairs.capacity + 1);
+
+            count = query(staticTree, RIGID_AABB_COLLIDER, &view, newVisiblePairs.first, start, newVisiblePairs.capacity);
+            count = query(dynamicTree, RIGID_AABB_COLLIDER, &view, newVisiblePairs.first, count, newVisiblePairs.capacity);
+        }
+
+        // the view was cut short
+        if (count == newVisiblePairs.capacity) { dropOverflow(); }
+
+        void* key = observerKey(observer);
+
+        for (int i = start; i < count; ++i) {
+            newVisiblePairs.second[i] = {key, RIGID_BODY};
+
+            int prev = findPair(visibleTable, visiblePairs, newVisiblePairs.first[i].body, key);
+
+            if (prev != -1) { visibleTable.matched[prev] = 1; }
+            else { addVisibilityEvent({observer, newVisiblePairs.first[i], VISIBILITY_ENTER}); }
+        }
+
+        newVisiblePairs.count = count;
+    };
+
+    void Handler::refreshObserver(int observer) {
+        // ? A body can only have entered or left a view that did not move if its bounds changed, and only if they were not
+        // ?  entirely inside or entirely outside of the view both before and after. Only those bodies need the exact test.
+
+        ZMath::Vec2D viewMin = observers.mins[observer];
+        ZMath::Vec2D viewMax = observers.maxes[observer];
+        AABB view(viewMin, viewMax);
+        void* key = observerKey(observer);
+
+        observerBodyTests += observedBounds.changedCount;
+
+        for (int j = 0; j < observedBounds.changedCount; ++j) {
+            int i = observedBounds.changed[j];
+            BodyRef ref = i < rbs.count ? BodyRef{rbs.rigidBodies[i], RIGID_BODY} : BodyRef{kbs.kinematicBodies[i - rbs.count], KINEMATIC_BODY};
+            ZMath::Vec2D min, max;
+            computeBounds(ref, min, max);
+
+            ViewOverlap before = findViewOverlap(observedBounds.mins[i], observedBounds.maxes[i], viewMin, viewMax);
+            ViewOverlap after = findViewOverlap(min, max, viewMin, viewMax);
+            if (before == after && after != VIEW_CROSSING) { continue; }
+
+            bool visible = after == VIEW_INSIDE || (after == VIEW_CROSSING && BodyAndCollider(ref, RIGID_AABB_COLLIDER, &view));
+            int prev = findPair(visibleTable, visiblePairs, ref.body, key);
+
+            if (visible && prev == -1) {
+                if (newVisiblePairs.count == newVisiblePairs.capacity && fixedMemory()) {
+                    dropOverflow();
+                    continue;
+                }
+
+                addPair(resource, newVisiblePairs, ref, {key, RIGID_BODY});
+                addVisibilityEvent({observer, ref, VISIBILITY_ENTER});
+
+            } else if (!visible && prev != -1) {
+                visiblePairs.first[prev].body = nullptr;
+                addVisibilityEvent({observer, ref, VISIBILITY_LEAVE});
+            }
+        }
+
+        // * Everything else stays visible.
+
+        int end = observers.start[observer] + observers.visible[observer];
+        if (!fixedMemory()) { reservePairs(resource, newVisiblePairs, newVisiblePairs.count + observers.visible[observer]); }
+
+        for (int i = observers.start[observer]; i < end; ++i) {
+            if (!visiblePairs.first[i].body) { continue; }
+
+            // bodies that do not fit are reported as having left
+            if (newVisiblePairs.count == newVisiblePairs.capacity) {
+                dropOverflow();
+                break;
+            }
+
+            visibleTable.matched[i] = 1;
+            newVisiblePairs.first[newVisiblePairs.count] = visiblePairs.first[i];
+            newVisiblePairs.second[newVisiblePairs.count++] = visiblePairs.second[i];
+        }
+    };
+
+    void Handler::findChangedBounds() {
+        observedBounds.changedCount = 0;
+
+        for (int i = 0; i < rbs.count + kbs.count; ++i) {
+            BodyRef ref = i < rbs.count ? BodyRef{rbs.rigidBodies[i], RIGID_BODY} : BodyRef{kbs.kinematicBodies[i - rbs.count], KINEMATIC_BODY};
+            ZMath::Vec2D min, max;
+
+            if (!computeBounds(ref, min, max)) { continue; } // bodies without a collider are never visible
+            if (min == observedBounds.mins[i] && max == observedBounds.maxes[i]) { continue; }
+
+            observedBounds.changed[observedBounds.changedCount++] = i;
+        }
+    };
+
+    void Handler::updateObservers() {
+        updateTrees();
+
+        // * The stored bounds only line up with the bodies if none were added, removed, or moved to another index.
+
+        int bodies = rbs.count + kbs.count;
+        bool refresh = !observedBounds.stored || observedBounds.generation != bodyIndexGeneration;
+
+        if (bodies > observedBounds.capacity) {
+            refresh = 1;
+
+            // every view is queried each step until the bounds fit
+            if (fixedMemory()) { dropOverflow(); }
+
+            else {
+                int capacity = observedBounds.capacity ? observedBounds.capacity : halfStartingSlots;
+                while (bodies > capacity) { capacity *= 2; }
+
+                freeArray(resource, observedBounds.mins, observedBounds.capacity);
+                freeArray(resource, observedBounds.maxes, observedBounds.capacity);
+                freeArray(resource, observedBounds.changed, observedBounds.capacity);
+
+                observedBounds.mins = allocArray<ZMath::Vec2D>(resource, capacity);
+                observedBounds.maxes = allocArray<ZMath::Vec2D>(resource, capacity);
+                observedBounds.changed = allocArray<int>(resource, capacity);
+                observedBounds.capacity = capacity;
+            }
+        }
+
+        // * Find the bodies in each view for this step. Each observer's pairs are kept together.
+
+        // ? Which bodies changed does not depend on the view, so it is found once instead of once per still view.
+        observerBodyTests = 0;
+        if (!refresh) { findChangedBounds(); }
+
+        buildPairTable(resource, visibleTable, visiblePairs);
+        newVisiblePairs.count = 0;
+
+        for (int i = 0; i < observers.count; ++i) {
+            int start = newVisiblePairs.count;
+
+            if (observers.active[i] && (refresh || observers.moved[i])) { queryObserver(i); }
+            else if (observers.active[i]) { refreshObserver(i); }
+
+            observers.start[i] = start;
+            observers.visible[i] = newVisiblePairs.count - start;
+            observers.moved[i] = 0;
+        }
+
+        // * Bodies from the previous step that were not found again left their view.
+
+        for (int i = 0; i < visiblePairs.count; ++i) {
+            if (visibleTable.matched[i] || !visiblePairs.first[i].body) { continue; }
+            addVisibilityEvent({(int) (uintptr_t) visiblePairs.second[i].body - 1, visiblePairs.first[i], VISIBILITY_LEAVE});
+        }
+
+        // * Remember the bounds the views were tested against.
+
+        observedBounds.stored = bodies <= observedBounds.capacity;
+        observedBounds.generation = bodyIndexGeneration;
+
+        // only the changed bounds differ from the stored ones unless everything was queried
+        if (observedBounds.stored && !refresh) {
+            for (int j = 0; j < observedBounds.changedCount; ++j) {
+                int i = observedBounds.changed[j];
+                computeBounds(i < rbs.count ? BodyRef{rbs.rigidBodies[i], RIGID_BODY} : BodyRef{kbs.kinematicBodies[i - rbs.count], KINEMATIC_BODY},
+                              observedBounds.mins[i], observedBounds.maxes[i]);
+            }
+
+        } else if (observedBounds.stored) {
+            for (int i = 0; i < rbs.count; ++i) {
+                observedBounds.mins[i] = rbs.rigidBodies[i]->boundsMin;
+                observedBounds.maxes[i] = rbs.rigidBodies[i]->boundsMax;
+            }
+
+            for (int i = 0; i < kbs.count; ++i) {
+                observedBounds.mins[rbs.count + i] = kbs.kinematicBodies[i]->boundsMin;
+                observedBounds.maxes[rbs.count + i] = kbs.kinematicBodies[i]->boundsMax;
+            }
+        }
+
+        // the current step's views become the previous step's
+        BodyPairs temp = visiblePairs;
+        visiblePairs = newVisiblePairs;
+        newVisiblePairs = temp;
+        newVisiblePairs.count = 0;
+    };
+
+
     // * ============================
     // * Main Physics Functions
     // * ============================
@@ -573,89 +1641,1065 @@ namespace Zeta {
     // dt will be updated to the appropriate value after the updates run for you so DO NOT modify it yourself.
     int Handler::update(float &dt) {
         int count = 0;
+        int iterations = IMPULSE_ITERATIONS;
+
+        sensorEvents.count = 0;
+        visibilityEvents.count = 0;
+        skippedTime = 0.0f;
+        memoryOverflows = 0;
+
+        addRemovedSensorEvents();
+
+        if (recorder) { recordUpdate(dt); }
+
+        std::chrono::steady_clock::time_point start;
+        if (stepBudget > 0.0f) { start = std::chrono::steady_clock::now(); }
+
+        // kinematic bodies are moved by the user, so their bounds are found again before they are used
+        for (int i = 0; i < kbs.count; ++i) { kbs.kinematicBodies[i]->updateBounds(); }
+        if (kbs.count) { dynamicTreeMoved = 1; }
+
+        updateLODIntervals();
 
         while (dt >= updateStep) {
-            // Broad phase: collision detection
-            // There will, on average, be too few kinematic bodies for it to be worth combining the loops
-            for (int i = 0; i < rbs.count - 1; ++i) {
-                for (int j = i + 1; j < rbs.count; ++j) {
-                    CollisionManifold result = findCollisionFeatures(rbs.rigidBodies[i], rbs.rigidBodies[j]);
-                    if (result.hit) { addCollision(rbs.rigidBodies[i], rbs.rigidBodies[j], result); }
-                }
+            // ? Once a limit is hit, either skip the remaining whole steps or finish them with a cheaper solver.
+            // ? The leftover partial step stays in dt either way so render interpolation is unaffected.
 
-                for (int j = 0; j < sbs.count; ++j) {
-                    CollisionManifold result = findCollisionFeatures(rbs.rigidBodies[i], sbs.staticBodies[j]);
-                    if (result.hit) { addCollision(rbs.rigidBodies[i], sbs.staticBodies[j], result); }
-                }
+            bool overBudget = stepBudget > 0.0f && count &&
+                              std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >= stepBudget;
 
-                for (int j = 0; j < kbs.count; ++j) {
-                    CollisionManifold result = findCollisionFeatures(rbs.rigidBodies[i], kbs.kinematicBodies[j]);
-                    if (result.hit) { addCollision(rbs.rigidBodies[i], kbs.kinematicBodies[j], result); }
-                }
+            if ((maxSteps > 0 && count >= maxSteps) || (overBudget && stepLimitMode == DROP_TIME)) {
+                float leftover = fmodf(dt, updateStep);
+
+                skippedTime = dt - leftover;
+                dt = leftover;
+                break;
             }
 
-            // check for kinematic body collisions
-            for (int i = 0; i < kbs.count; ++i) {
-                for (int j = i + 1; j < kbs.count; ++j) {
-                    CollisionManifold result = findCollisionFeatures(kbs.kinematicBodies[i], kbs.kinematicBodies[j]);
-                    if (result.hit) { addCollision(kbs.kinematicBodies[i], kbs.kinematicBodies[j], result); }
-                }
+            if (overBudget) { iterations = 1; }
 
-                for (int j = 0; j < sbs.count; ++j) {
-                    CollisionManifold result = findCollisionFeatures(kbs.kinematicBodies[i], sbs.staticBodies[j]);
-                    if (result.hit) { addCollision(sbs.staticBodies[j], kbs.kinematicBodies[i], result); }
+            // the intervals were found for the old order
+            if (reorderInterval > 0 && stepCounter % reorderInterval == 0) {
+                reorderRigidBodies();
+                updateLODIntervals();
+            }
+
+            lod.skippedCount = 0;
+
+            if (lod.enabled) {
+                for (int i = 0; i < rbs.count; ++i) {
+                    lod.stepped[i] = (stepCounter + rbs.rigidBodies[i]->lodPhase) % lod.intervals[i] == 0;
+                    if (!lod.stepped[i]) { lod.skipped[lod.skippedCount++] = rbs.rigidBodies[i]; }
                 }
             }
 
-            // todo update to not be through iterative deepening -- look into this in the future
-            // todo use spatial partitioning
-            // Narrow phase: Impulse resolution
-            for (int k = 0; k < IMPULSE_ITERATIONS; ++k) {
-                if (colWrapper.count > staticColWrapper.count) { // staticColWrapper is the shorter of the two.
-                    for (int i = 0; i < staticColWrapper.count; ++i) {
-                        applyImpulse(colWrapper.bodies1[i], colWrapper.bodies2[i], colWrapper.manifolds[i]);
-                        applyImpulse(staticColWrapper.rbs[i], staticColWrapper.sbs[i], staticColWrapper.manifolds[i]);
-                    }
+            // Broad phase: collision detection
+            // There will, on average, be too few kinematic bodies for it to be worth combining the loops
+            // Pairs involving a sensor only check for overlap and skip manifold generation entirely
+            for (int i = 0; i < rbs.count; ++i) {
+                RigidBody2D* rb = rbs.rigidBodies[i];
+                bool stepped = isStepped(i);
 
-                    for (int i = staticColWrapper.count; i < colWrapper.count; ++i) {
-                        applyImpulse(colWrapper.bodies1[i], colWrapper.bodies2[i], colWrapper.manifolds[i]);
-                    }
+                // how far the body moves during this step, which only matters to speculative contacts
+                float step = getStepLength(i);
+                ZMath::Vec2D disp = speculativeContacts ? predictVel(rb, g, step) * step : ZMath::Vec2D(0, 0);
 
-                } else { // colWrapper is the shorter or the two or they are equal.
-                    for (int i = 0; i < colWrapper.count; ++i) {
-                        applyImpulse(colWrapper.bodies1[i], colWrapper.bodies2[i], colWrapper.manifolds[i]);
-                        applyImpulse(staticColWrapper.rbs[i], staticColWrapper.sbs[i], staticColWrapper.manifolds[i]);
+                for (int j = i + 1; j < rbs.count; ++j) {
+                    RigidBody2D* rb2 = rbs.rigidBodies[j];
+                    float step2 = speculativeContacts ? getStepLength(j) : 0.0f;
+                    ZMath::Vec2D disp2 = speculativeContacts ? predictVel(rb2, g, step2) * step2 : ZMath::Vec2D(0, 0);
+
+                    // ? Only a speculative contact can come out of a pair whose cached bounds are apart, and only if they
+                    // ?  meet once grown by how far each body moves.
+                    bool near = boundsOverlap(rb, rb2);
+                    if (!near && (!speculativeContacts || !sweptBoundsOverlap(rb, disp, rb2, disp2))) { continue; }
+
+                    if (rb->sensor || rb2->sensor) {
+                        if (!near || !RigidAndRigid(rb, rb2)) { continue; }
+
+                        if (rb->sensor) { addSensorPair({rb, RIGID_BODY}, {rb2, RIGID_BODY}); }
+                        else { addSensorPair({rb2, RIGID_BODY}, {rb, RIGID_BODY}); }
+
+                        continue;
                     }
 
-                    for (int i = colWrapper.count; i < staticColWrapper.count; ++i) {
-                        applyImpulse(staticColWrapper.rbs[i], staticColWrapper.sbs[i], staticColWrapper.manifolds[i]);
+                    if (!stepped && !isStepped(j)) { continue; }
+
+                    // ? A full list that cannot grow only checks for overlap to count the contacts it drops.
+                    // ? Skipping the manifold also keeps the contact points from overflowing the frame arena.
+                    if (colWrapper.count == colWrapper.capacity && fixedMemory()) {
+                        if (near && RigidAndRigid(rb, rb2)) { dropOverflow(); }
+                        continue;
                     }
-                }
 
-                // resolve kinematic body collisions
-                // There will, on average, be too few kinematic bodies for it to be worth combining the loops
-                for (int i = 0; i < rkColWrapper.count; ++i) {
-                    applyImpulse(rkColWrapper.rbs[i], rkColWrapper.kbs[i], rkColWrapper.manifolds[i]);
-                }
+                    CollisionManifold result = near ? findCollisionFeatures(rb, rb2, &frameArena) : CollisionManifold();
+                    if (result.hit) { addCollision(rb, rb2, result); }
 
-                for (int i = 0; i < skColWrapper.count; ++i) {
-                    applyImpulse(skColWrapper.kbs[i], skColWrapper.sbs[i], skColWrapper.manifolds[i]);
-                }
+                    else if (speculativeContacts && findSpeculativeContact(rb, {rb2, RIGID_BODY}, disp - disp2, MAX(step, step2), updateStep, result)) {
 
-                for (int i = 0; i < kColWrapper.count; ++i) {
-                    applyImpulse(kColWrapper.kb1s[i], kColWrapper.kb2s[i], kColWrapper.manifolds[i]);
+                        result.normal = -result.normal; // the normal has to point towards rb2
+                        addCollision(rb, rb2, result);
+                    }
                 }
-            }
 
-            clearCollisions();
+                for (int j = 0; j < sbs.count; ++j) {
+                    StaticBody2D* sb = sbs.staticBodies[j];
+
+                    bool near = boundsOverlap(rb, sb);
+                    if (!near && (!speculativeContacts || !sweptBoundsOverlap(rb, disp, sb, ZMath::Vec2D(0, 0)))) { continue; }
+
+                    if (rb->sensor || sb->sensor) {
+                        if (!near || !RigidAndStatic(rb, sb)) { continue; }
+
+                        if (rb->sensor) { addSensorPair({rb, RIGID_BODY}, {sb, STATIC_BODY}); }
+                        else { addSensorPair({sb, STATIC_BODY}, {rb, RIGID_BODY}); }
+
+                        continue;
+                    }
+
+                    if (!stepped) { continue; }
+
+                    if (staticColWrapper.count == staticColWrapper.capacity && fixedMemory()) {
+                        if (near && RigidAndStatic(rb, sb)) { dropOverflow(); }
+                        continue;
+                    }
+
+                    CollisionManifold result = near ? findCollisionFeatures(rb, sb, &frameArena) : CollisionManifold();
+                    if (result.hit) { addCollision(rb, sb, result); }
+
+                    else if (speculativeContacts && findSpeculativeContact(rb, {sb, STATIC_BODY}, disp, step, updateStep, result)) {
+                        addCollision(rb, sb, result);
+                    }
+                }
+
+                for (int j = 0; j < kbs.count; ++j) {
+                    KinematicBody2D* kb = kbs.kinematicBodies[j];
+
+                    bool near = boundsOverlap(rb, kb);
+                    if (!near && (!speculativeContacts || !sweptBoundsOverlap(rb, disp, kb, kb->vel * step))) { continue; }
+
+                    if (rb->sensor || kb->sensor) {
+                        if (!near || !RigidAndKinematic(rb, kb)) { continue; }
+
+                        if (rb->sensor) { addSensorPair({rb, RIGID_BODY}, {kb, KINEMATIC_BODY}); }
+                        else { addSensorPair({kb, KINEMATIC_BODY}, {rb, RIGID_BODY}); }
+
+                        continue;
+                    }
+
+                    if (!stepped) { continue; }
+
+                    if (rkColWrapper.count == rkColWrapper.capacity && fixedMemory()) {
+                        if (near && RigidAndKinematic(rb, kb)) { dropOverflow(); }
+                        continue;
+                    }
+
+                    CollisionManifold result = near ? findCollisionFeatures(rb, kb, &frameArena) : CollisionManifold();
+                    if (result.hit) { addCollision(rb, kb, result); }
+
+                    else if (speculativeContacts && findSpeculativeContact(rb, {kb, KINEMATIC_BODY}, disp - kb->vel * step, step, updateStep, result)) {
+
+                        addCollision(rb, kb, result);
+                    }
+                }
+            }
+
+            // check for kinematic body collisions
+            for (int i = 0; i < kbs.count; ++i) {
+                KinematicBody2D* kb = kbs.kinematicBodies[i];
+
+                for (int j = i + 1; j < kbs.count; ++j) {
+                    KinematicBody2D* kb2 = kbs.kinematicBodies[j];
+                    if (!boundsOverlap(kb, kb2)) { continue; }
+
+                    if (kb->sensor || kb2->sensor) {
+                        if (!KinematicAndKinematic(kb, kb2)) { continue; }
+
+                        if (kb->sensor) { addSensorPair({kb, KINEMATIC_BODY}, {kb2, KINEMATIC_BODY}); }
+                        else { addSensorPair({kb2, KINEMATIC_BODY}, {kb, KINEMATIC_BODY}); }
+
+                        continue;
+                    }
+
+                    if (kColWrapper.count == kColWrapper.capacity && fixedMemory()) {
+                        if (KinematicAndKinematic(kb, kb2)) { dropOverflow(); }
+                        continue;
+                    }
+
+                    CollisionManifold result = findCollisionFeatures(kb, kb2, &frameArena);
+                    if (result.hit) { addCollision(kb, kb2, result); }
+                }
+
+                for (int j = 0; j < sbs.count; ++j) {
+                    StaticBody2D* sb = sbs.staticBodies[j];
+                    if (!boundsOverlap(kb, sb)) { continue; }
+
+                    if (kb->sensor || sb->sensor) {
+                        if (!KinematicAndStatic(kb, sb)) { continue; }
+
+                        if (kb->sensor) { addSensorPair({kb, KINEMATIC_BODY}, {sb, STATIC_BODY}); }
+                        else { addSensorPair({sb, STATIC_BODY}, {kb, KINEMATIC_BODY}); }
+
+                        continue;
+                    }
+
+                    if (skColWrapper.count == skColWrapper.capacity && fixedMemory()) {
+                        if (KinematicAndStatic(kb, sb)) { dropOverflow(); }
+                        continue;
+                    }
+
+                    CollisionManifold result = findCollisionFeatures(kb, sb, &frameArena);
+                    if (result.hit) { addCollision(sb, kb, result); }
+                }
+            }
+
+            updateSensorEvents();
+            if (contactEvents) { updateContactEvents(); }
+
+            // todo update to not be through iterative deepening -- look into this in the future
+            // todo use spatial partitioning
+            // Narrow phase: Impulse resolution
+            for (int k = 0; k < iterations; ++k) {
+                if (colWrapper.count > staticColWrapper.count) { // staticColWrapper is the shorter of the two.
+                    for (int i = 0; i < staticColWrapper.count; ++i) {
+                        resolveContact(colWrapper.bodies1[i], colWrapper.bodies2[i], colWrapper.manifolds[i]);
+                        resolveContact(staticColWrapper.rbs[i], staticColWrapper.sbs[i], staticColWrapper.manifolds[i]);
+                    }
+
+                    for (int i = staticColWrapper.count; i < colWrapper.count; ++i) {
+                        resolveContact(colWrapper.bodies1[i], colWrapper.bodies2[i], colWrapper.manifolds[i]);
+                    }
+
+                } else { // colWrapper is the shorter or the two or they are equal.
+                    for (int i = 0; i < colWrapper.count; ++i) {
+                        resolveContact(colWrapper.bodies1[i], colWrapper.bodies2[i], colWrapper.manifolds[i]);
+                        resolveContact(staticColWrapper.rbs[i], staticColWrapper.sbs[i], staticColWrapper.manifolds[i]);
+                    }
+
+                    for (int i = colWrapper.count; i < staticColWrapper.count; ++i) {
+                        resolveContact(staticColWrapper.rbs[i], staticColWrapper.sbs[i], staticColWrapper.manifolds[i]);
+                    }
+                }
+
+                // resolve kinematic body collisions
+                // There will, on average, be too few kinematic bodies for it to be worth combining the loops
+                for (int i = 0; i < rkColWrapper.count; ++i) {
+                    resolveContact(rkColWrapper.rbs[i], rkColWrapper.kbs[i], rkColWrapper.manifolds[i]);
+                }
+
+                for (int i = 0; i < skColWrapper.count; ++i) {
+                    applyImpulse(skColWrapper.kbs[i], skColWrapper.sbs[i], skColWrapper.manifolds[i]);
+                }
+
+                for (int i = 0; i < kColWrapper.count; ++i) {
+                    applyImpulse(kColWrapper.kb1s[i], kColWrapper.kb2s[i], kColWrapper.manifolds[i]);
+                }
+            }
+
+            clearCollisions();
+
+            // only the start of the last step is needed for interpolation
+            // a step budget can end the loop at any step so every step has to be stored then
+            if (dt < 2*updateStep || (maxSteps > 0 && count == maxSteps - 1) || stepBudget > 0.0f) { storePositions(1); }
 
             // Update our rigidbodies
-            for (int i = 0; i < rbs.count; ++i) { rbs.rigidBodies[i]->update(g, updateStep); }
+            for (int i = 0; i < rbs.count; ++i) {
+                if (!isStepped(i)) { continue; }
+
+                RigidBody2D* rb = rbs.rigidBodies[i];
+                float step = getStepLength(i);
+
+                if (rb->bullet && !rb->sensor && rb->colliderType != RIGID_NONE) { updateBullet(rb, step); }
+                else { rb->update(g, step); }
+            }
 
             dt -= updateStep;
+            ++stepCounter;
             ++count;
         }
 
+        if (count) {
+            storePositions(0);
+            dynamicTreeMoved = 1;
+
+            if (observers.count) { updateObservers(); }
+        }
+
+        alpha = dt/updateStep;
+
         return count;
     };
+
+
+    // * =========================
+    // * Reordering
+    // * =========================
+
+    // Spread the lower 16 bits of v out to the even bits.
+    static inline uint32_t spreadBits(uint32_t v) {
+        v &= 0x0000FFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+
+        return v;
+    };
+
+    // Quantize t to 16 bits. Anything that is not a finite number between 0 and 1 is clamped.
+    static inline uint32_t quantize16(float t) {
+        if (!(t > 0.0f)) { return 0; }
+        if (t >= 1.0f) { return 0xFFFF; }
+
+        return (uint32_t) (t * 65535.0f);
+    };
+
+    void Handler::reorderRigidBodies() {
+        if (rbs.count < 2) { return; }
+
+        if (rbs.count > morton.capacity) {
+            // the bodies keep their order until the entries fit
+            if (fixedMemory()) {
+                dropOverflow();
+                return;
+            }
+
+            freeArray(resource, morton.entries, morton.capacity);
+
+            morton.capacity = rbs.capacity;
+            morton.entries = allocArray<MortonEntry>(resource, morton.capacity);
+        }
+
+        ZMath::Vec2D min = rbs.rigidBodies[0]->pos, max = min;
+
+        for (int i = 1; i < rbs.count; ++i) {
+            ZMath::Vec2D const &pos = rbs.rigidBodies[i]->pos;
+
+            min.x = MIN(min.x, pos.x);
+            min.y = MIN(min.y, pos.y);
+            max.x = MAX(max.x, pos.x);
+            max.y = MAX(max.y, pos.y);
+        }
+
+        // ? A body that exploded can stretch the extent until every other body shares a cell, which only costs us the sort order.
+        float scaleX = max.x - min.x > 0.0f ? 1.0f/(max.x - min.x) : 0.0f;
+        float scaleY = max.y - min.y > 0.0f ? 1.0f/(max.y - min.y) : 0.0f;
+
+        for (int i = 0; i < rbs.count; ++i) {
+            RigidBody2D* rb = rbs.rigidBodies[i];
+
+            uint32_t x = quantize16((rb->pos.x - min.x)*scaleX);
+            uint32_t y = quantize16((rb->pos.y - min.y)*scaleY);
+
+            morton.entries[i] = {spreadBits(x) | (spreadBits(y) << 1), i, rb};
+        }
+
+        // ? Ties keep their current order so the result only depends on the state of the handler.
+        // ? std::stable_sort would do that too, but it allocates a buffer.
+        std::sort(morton.entries, morton.entries + rbs.count, [](MortonEntry const &a, MortonEntry const &b) {
+            return a.key < b.key || (a.key == b.key && a.index < b.index);
+        });
+
+        for (int i = 0; i < rbs.count; ++i) {
+            rbs.rigidBodies[i] = morton.entries[i].rb;
+            setRigidBodyIndex(rbs.rigidBodies[i], i);
+        }
+
+        // the same bodies are in the tree, only their order in the handler changed
+        ++bodyIndexGeneration;
+    };
+
+
+    // * =========================
+    // * Level of Detail
+    // * =========================
+
+    void Handler::updateLODIntervals() {
+        lod.enabled = 0;
+
+        if (rbs.count > lod.capacity) {
+            // every body is stepped at the full rate until the intervals fit
+            if (fixedMemory()) {
+                dropOverflow();
+                return;
+            }
+
+            freeArray(resource, lod.intervals, lod.capacity);
+            freeArray(resource, lod.stepped, lod.capacity);
+            freeArray(resource, lod.skipped, lod.capacity);
+
+            lod.capacity = rbs.capacity;
+            lod.intervals = allocArray<int>(resource, lod.capacity);
+            lod.stepped = allocArray<bool>(resource, lod.capacity);
+            lod.skipped = allocArray<RigidBody2D*>(resource, lod.capacity);
+        }
+
+        for (int i = 0; i < rbs.count; ++i) {
+            RigidBody2D* rb = rbs.rigidBodies[i];
+            lod.intervals[i] = 1;
+
+            if (rb->lodTier <= 0) { continue; }
+
+            ZMath::Vec2D min, max;
+            bool active = 0;
+
+            if (computeBounds({rb, RIGID_BODY}, min, max)) {
+                for (int j = 0; j < activeRegions.count && !active; ++j) {
+                    active = min.x <= activeRegions.maxes[j].x && activeRegions.mins[j].x <= max.x &&
+                             min.y <= activeRegions.maxes[j].y && activeRegions.mins[j].y <= max.y;
+                }
+
+            } else {
+                // bodies without a collider are checked by their position
+                for (int j = 0; j < activeRegions.count && !active; ++j) {
+                    active = ZMath::clamp(rb->pos, activeRegions.mins[j], activeRegions.maxes[j]) == rb->pos;
+                }
+            }
+
+            if (active) { continue; }
+
+            int interval = lodIntervals[MIN(rb->lodTier, LOD_TIERS - 1)];
+            lod.intervals[i] = MAX(interval, 1);
+            if (lod.intervals[i] > 1) { lod.enabled = 1; }
+        }
+    };
+
+    void Handler::setActiveRegions(AABB const* regions, int count) {
+        if (count > activeRegions.capacity) {
+            freeArray(resource, activeRegions.mins, activeRegions.capacity);
+            freeArray(resource, activeRegions.maxes, activeRegions.capacity);
+
+            activeRegions.capacity = count;
+            activeRegions.mins = allocArray<ZMath::Vec2D>(resource, count);
+            activeRegions.maxes = allocArray<ZMath::Vec2D>(resource, count);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            activeRegions.mins[i] = regions[i].getMin();
+            activeRegions.maxes[i] = regions[i].getMax();
+        }
+
+        activeRegions.count = count;
+        if (recorder) { recorder->recordActiveRegions(activeRegions.mins, activeRegions.maxes, count); }
+    };
+
+
+    // * ======================
+    // * Frame Memory
+    // * ======================
+
+    void Handler::reserveFrameMemory(size_t bytes) {
+        frameArena.reserve(bytes);
+
+        // the collision wrappers are always empty between steps, so they can be moved into the larger buffer right away
+        clearCollisions();
+    };
+
+
+    // * ======================
+    // * Reserved Memory
+    // * ======================
+
+    void Handler::reserve(int maxBodies, int maxContacts, int maxVisible) {
+        // * Bodies
+
+        reserveRigidBodies(maxBodies);
+
+        if (maxBodies > lod.capacity) {
+            freeArray(resource, lod.intervals, lod.capacity);
+            freeArray(resource, lod.stepped, lod.capacity);
+            freeArray(resource, lod.skipped, lod.capacity);
+
+            lod.capacity = maxBodies;
+            lod.intervals = allocArray<int>(resource, lod.capacity);
+            lod.stepped = allocArray<bool>(resource, lod.capacity);
+            lod.skipped = allocArray<RigidBody2D*>(resource, lod.capacity);
+        }
+
+        if (maxBodies > morton.capacity) {
+            freeArray(resource, morton.entries, morton.capacity);
+
+            morton.capacity = maxBodies;
+            morton.entries = allocArray<MortonEntry>(resource, morton.capacity);
+        }
+
+        if (maxBodies > interpolation.capacity) {
+            freeArray(resource, interpolation.prev, interpolation.capacity);
+            freeArray(resource, interpolation.curr, interpolation.capacity);
+
+            interpolation.prev = allocArray<ZMath::Vec2D>(resource, maxBodies);
+            interpolation.curr = allocArray<ZMath::Vec2D>(resource, maxBodies);
+            interpolation.capacity = maxBodies;
+            interpolation.count = 0; // render the current positions until the next step
+        }
+
+
+        // * Collisions
+
+        if (maxContacts > reservedContacts) { reservedContacts = maxContacts; }
+
+        // ? Each of the five collision lists holds reservedContacts bodies, manifolds, and up to 2 contact points per manifold.
+        // ? Every array in the arena is padded to alignof(std::max_align_t) at worst.
+        size_t contactBytes = 2*sizeof(void*) + sizeof(CollisionManifold) + 2*sizeof(ZMath::Vec2D);
+        frameArena.reserve(5*(reservedContacts*contactBytes + 4*alignof(std::max_align_t)));
+        clearCollisions();
+
+
+        // * Sensors
+
+        reservePairs(resource, sensorPairs, reservedContacts);
+        reservePairs(resource, newSensorPairs, reservedContacts);
+        reservePairs(resource, removedSensorPairs, reservedContacts);
+        reservePairTable(resource, sensorTable, MAX(sensorPairs.capacity, newSensorPairs.capacity));
+
+        // every overlap can end and a new one begin during each step, after the overlaps ended by removals are reported
+        int steps = maxSteps > 0 ? maxSteps : 1;
+        reserveEvents(resource, sensorEvents, (2*steps + 1)*MAX(sensorPairs.capacity, newSensorPairs.capacity));
+
+        if (contactEvents) {
+            reservePairs(resource, contactPairs, reservedContacts);
+            reservePairs(resource, newContactPairs, reservedContacts);
+            reservePairTable(resource, contactTable, MAX(contactPairs.capacity, newContactPairs.capacity));
+        }
+
+
+        // * Observers
+
+        if (observers.capacity) {
+            // ? Sizing for every observer seeing every body grows with observers times bodies, which is far more than
+            // ?  observers spread over the world ever see, so only the visible set the caller expects is reserved.
+            int visible = maxVisible > 0 ? maxVisible : maxBodies + sbs.count;
+
+            reservePairs(resource, visiblePairs, visible);
+            reservePairs(resource, newVisiblePairs, visible);
+            reservePairTable(resource, visibleTable, MAX(visiblePairs.capacity, newVisiblePairs.capacity));
+            reserveEvents(resource, visibilityEvents, 2*MAX(visiblePairs.capacity, newVisiblePairs.capacity));
+
+            if (maxBodies > observedBounds.capacity) {
+                freeArray(resource, observedBounds.mins, observedBounds.capacity);
+                freeArray(resource, observedBounds.maxes, observedBounds.capacity);
+                freeArray(resource, observedBounds.changed, observedBounds.capacity);
+
+                observedBounds.mins = allocArray<ZMath::Vec2D>(resource, maxBodies);
+                observedBounds.maxes = allocArray<ZMath::Vec2D>(resource, maxBodies);
+                observedBounds.changed = allocArray<int>(resource, maxBodies);
+                observedBounds.capacity = maxBodies;
+                observedBounds.stored = 0;
+            }
+        }
+    };
+
+    void Handler::dropOverflow() {
+        if (memoryLimitMode == THROW_ON_OVERFLOW) { throw std::runtime_error("PhysicsHandler ran out of reserved memory during a step."); }
+        ++memoryOverflows;
+    };
+
+
+    // * ======================
+    // * Recording
+    // * ======================
+
+    void Handler::setRecorder(Recorder* recorder) {
+        this->recorder = recorder;
+        if (!recorder) { return; }
+
+        // ? Record the current state as if it were built from scratch so the recording replays into an empty handler.
+
+        recordSettings();
+
+        for (int i = 0; i < rbs.count; ++i) { recorder->recordAdd(RIGID_BODY, rbs.rigidBodies[i]); }
+        for (int i = 0; i < sbs.count; ++i) { recorder->recordAdd(STATIC_BODY, sbs.staticBodies[i]); }
+        for (int i = 0; i < kbs.count; ++i) { recorder->recordAdd(KINEMATIC_BODY, kbs.kinematicBodies[i]); }
+
+        if (activeRegions.count) { recorder->recordActiveRegions(activeRegions.mins, activeRegions.maxes, activeRegions.count); }
+    };
+
+    static_assert(sizeof(RecordSettings::lodIntervals) == sizeof(int)*LOD_TIERS, "RecordSettings must hold every level of detail tier.");
+
+    void Handler::recordSettings() {
+        RecordSettings settings;
+
+        settings.g = g;
+        settings.updateStep = updateStep;
+        settings.stepBudget = stepBudget;
+        settings.maxSteps = maxSteps;
+        settings.stepLimitMode = stepLimitMode;
+        settings.speculativeContacts = speculativeContacts;
+        settings.reorderInterval = reorderInterval;
+
+        for (int i = 0; i < LOD_TIERS; ++i) { settings.lodIntervals[i] = lodIntervals[i]; }
+
+        recorder->recordSettings(settings);
+    };
+
+    void Handler::recordUpdate(float dt) {
+        recordSettings();
+
+        // ? Forces are set on the bodies directly so record whatever is on them going into the update.
+        for (int i = 0; i < rbs.count; ++i) {
+            ZMath::Vec2D const &force = rbs.rigidBodies[i]->netForce;
+            if (force.x || force.y) { recorder->recordForce(i, force); }
+        }
+
+        recorder->recordUpdate(dt);
+    };
+
+
+    // * ======================
+    // * Scenes
+    // * ======================
+
+    bool Handler::saveScene(char const* path) {
+        updateStaticTree();
+        return writeScene(path, sbs.staticBodies, sbs.count, staticTree);
+    };
+
+    bool Handler::loadScene(char const* path) {
+        if (scene) { return 0; }
+
+        scene = newObject<SceneFile>(resource);
+
+        if (!scene->open(path)) {
+            deleteObject(resource, scene);
+            scene = nullptr;
+            return 0;
+        }
+
+        SceneHeader const* header = scene->getHeader();
+        StaticBody2D* bodies = scene->getBodies();
+        int count = header->bodyCount;
+
+        // the tree can only be reused if it covers every static body
+        bool useTree = !sbs.count;
+
+        if (sbs.count + count > sbs.capacity) {
+            int oldCapacity = sbs.capacity;
+
+            do { sbs.capacity *= 2; } while(sbs.count + count > sbs.capacity);
+            StaticBody2D** temp = allocArray<StaticBody2D*>(resource, sbs.capacity);
+
+            for (int i = 0; i < sbs.count; ++i) { temp[i] = sbs.staticBodies[i]; }
+
+            freeArray(resource, sbs.staticBodies, oldCapacity);
+            sbs.staticBodies = temp;
+        }
+
+        for (int i = 0; i < count; ++i) { sbs.staticBodies[sbs.count++] = bodies + i; }
+        for (int i = 0; i < count && recorder; ++i) { recorder->recordAdd(STATIC_BODY, bodies + i); }
+
+        staticTree.reserve(sbs.count);
+        ++bodyIndexGeneration;
+        ++bodySetGeneration;
+
+        if (!useTree) {
+            staticTreeDirty = 1;
+            return 1;
+        }
+
+        // ? Item i of the stored tree is body i so the items only need their bounds and a pointer into the mapping.
+        // ? reserve allocates 2x the item capacity for the nodes which is always enough for a valid scene.
+
+        ZMath::Vec2D const* bounds = scene->getBounds();
+
+        for (uint32_t i = 0; i < header->itemCount; ++i) {
+            staticTree.items[i].min = bounds[2*i];
+            staticTree.items[i].max = bounds[2*i + 1];
+            staticTree.items[i].ref = {bodies + i, STATIC_BODY};
+            staticTree.items[i].index = i;
+        }
+
+        memcpy(staticTree.nodes, scene->getNodes(), header->nodeCount * sizeof(BVHNode));
+
+        staticTree.itemCount = header->itemCount;
+        staticTree.nodeCount = header->nodeCount;
+        staticTreeDirty = 0;
+
+        return 1;
+    };
+
+
+    // * ======================
+    // * Snapshots
+    // * ======================
+
+    // ? Bodies are copied as raw bytes, so they have to stay trivially copyable.
+    static_assert(std::is_trivially_copyable<RigidBody2D>::value, "RigidBody2D must be trivially copyable for snapshots.");
+    static_assert(std::is_trivially_copyable<StaticBody2D>::value, "StaticBody2D must be trivially copyable for snapshots.");
+    static_assert(std::is_trivially_copyable<KinematicBody2D>::value, "KinematicBody2D must be trivially copyable for snapshots.");
+
+    // Stored at the start of every snapshot followed by the rigid then kinematic bodies.
+    // Static bodies never move, so they are left out and only their count is checked.
+    struct SnapshotHeader {
+        unsigned int bodySetGeneration; // Handler::bodySetGeneration when the snapshot was saved
+        int rigidCount;
+        int staticCount;
+        int kinematicCount;
+        unsigned int stepCounter; // keeps the level of detail stagger in sync when re-simulating
+    };
+
+    size_t Handler::getSnapshotSize() const {
+        return sizeof(SnapshotHeader) + rbs.count*(sizeof(RigidBody2D) + sizeof(RigidBody2D*)) + kbs.count*sizeof(KinematicBody2D);
+    };
+
+    size_t Handler::saveSnapshot(void* buffer, size_t capacity) const {
+        size_t size = getSnapshotSize();
+        if (size > capacity) { return 0; }
+
+        SnapshotHeader header = {bodySetGeneration, rbs.count, sbs.count, kbs.count, stepCounter};
+        char* out = (char*) buffer;
+
+        memcpy(out, &header, sizeof(SnapshotHeader));
+        out += sizeof(SnapshotHeader);
+
+        for (int i = 0; i < rbs.count; ++i, out += sizeof(RigidBody2D)) { memcpy(out, rbs.rigidBodies[i], sizeof(RigidBody2D)); }
+        for (int i = 0; i < kbs.count; ++i, out += sizeof(KinematicBody2D)) { memcpy(out, kbs.kinematicBodies[i], sizeof(KinematicBody2D)); }
+
+        // the order of the rigid bodies since a reorder can happen between saving and restoring
+        memcpy(out, rbs.rigidBodies, rbs.count*sizeof(RigidBody2D*));
+
+        return size;
+    };
+
+    bool Handler::restoreSnapshot(void const* buffer, size_t size) {
+        if (size < sizeof(SnapshotHeader) || size != getSnapshotSize()) { return 0; }
+
+        SnapshotHeader header;
+        char const* in = (char const*) buffer;
+
+        memcpy(&header, in, sizeof(SnapshotHeader));
+        in += sizeof(SnapshotHeader);
+
+        // ? Matching counts are not enough: a body removed and another added in its place would have the snapshot write
+        // ?  through the pointers of bodies the handler no longer holds. Any change to which bodies are held bumps the generation.
+        if (header.bodySetGeneration != bodySetGeneration || header.rigidCount != rbs.count || header.staticCount != sbs.count ||
+            header.kinematicCount != kbs.count) { return 0; }
+
+        char const* rigid = in;
+        in += rbs.count*sizeof(RigidBody2D);
+
+        for (int i = 0; i < kbs.count; ++i, in += sizeof(KinematicBody2D)) { memcpy(kbs.kinematicBodies[i], in, sizeof(KinematicBody2D)); }
+
+        memcpy(rbs.rigidBodies, in, rbs.count*sizeof(RigidBody2D*));
+
+        for (int i = 0; i < rbs.count; ++i, rigid += sizeof(RigidBody2D)) {
+            memcpy(rbs.rigidBodies[i], rigid, sizeof(RigidBody2D));
+            setRigidBodyIndex(rbs.rigidBodies[i], i);
+        }
+
+        stepCounter = header.stepCounter;
+
+        // ? Every rigid and kinematic body may have moved. The static bodies were not touched, so the static tree
+        // ?  (including one loaded with a scene) is kept as it is.
+        dynamicTreeDirty = 1;
+        ++bodyIndexGeneration;
+        interpolation.count = 0;
+
+        return 1;
+    };
+
+
+    // * ======================
+    // * Checksums
+    // * ======================
+
+    // Mix a 32 bit word into a running hash.
+    static inline unsigned long long mixHash(unsigned long long h, unsigned int word) {
+        h = (h ^ word) * 0x100000001B3ULL;
+        return h ^ (h >> 29);
+    };
+
+    // Mix the bits of a vector into a running hash.
+    static inline unsigned long long mixHash(unsigned long long h, ZMath::Vec2D const &v) {
+        unsigned int x, y;
+        memcpy(&x, &v.x, sizeof(float));
+        memcpy(&y, &v.y, sizeof(float));
+
+        return mixHash(mixHash(h, x), y);
+    };
+
+    unsigned long long Handler::getChecksum() const {
+        unsigned long long h = 0xCBF29CE484222325ULL;
+
+        h = mixHash(h, stepCounter);
+        h = mixHash(h, (unsigned int) rbs.count);
+        h = mixHash(h, (unsigned int) kbs.count);
+
+        for (int i = 0; i < rbs.count; ++i) { h = mixHash(mixHash(h, rbs.rigidBodies[i]->pos), rbs.rigidBodies[i]->vel); }
+        for (int i = 0; i < kbs.count; ++i) { h = mixHash(mixHash(h, kbs.kinematicBodies[i]->pos), kbs.kinematicBodies[i]->vel); }
+
+        return h;
+    };
+
+
+    // * ============================
+    // * Render Interpolation
+    // * ============================
+
+    void Handler::storePositions(bool previous) {
+        int count = rbs.count + kbs.count;
+
+        // ? The start of the last step is always stored before its end, so the buffers only ever need to grow here
+        // ?  and neither side holds anything worth keeping when they do.
+
+        if (previous && count > interpolation.capacity && fixedMemory()) { dropOverflow(); }
+
+        else if (previous && count > interpolation.capacity) {
+            int capacity = interpolation.capacity ? interpolation.capacity : halfStartingSlots;
+            while (count > capacity) { capacity *= 2; }
+
+            freeArray(resource, interpolation.prev, interpolation.capacity);
+            freeArray(resource, interpolation.curr, interpolation.capacity);
+
+            interpolation.prev = allocArray<ZMath::Vec2D>(resource, capacity);
+            interpolation.curr = allocArray<ZMath::Vec2D>(resource, capacity);
+            interpolation.capacity = capacity;
+        }
+
+        // the buffers could not grow so render the current positions instead
+        if (count > interpolation.capacity) {
+            interpolation.count = 0;
+            return;
+        }
+
+        // ? Both ends have to be stored for the same bodies in the same order, so the end of the step only counts
+        // ?  if nothing moved the bodies around since its start was stored.
+        if (previous) { interpolation.generation = bodyIndexGeneration; }
+        else if (interpolation.generation != bodyIndexGeneration) {
+            interpolation.count = 0;
+            return;
+        }
+
+        ZMath::Vec2D* positions = previous ? interpolation.prev : interpolation.curr;
+
+        for (int i = 0; i < rbs.count; ++i) { positions[i] = rbs.rigidBodies[i]->pos; }
+        for (int i = 0; i < kbs.count; ++i) { positions[rbs.count + i] = kbs.kinematicBodies[i]->pos; }
+
+        interpolation.count = count;
+    };
+
+    int Handler::getInterpolatedPositions(ZMath::Vec2D* positions, int capacity) const {
+        int count = MIN(rbs.count + kbs.count, capacity);
+
+        // the buffers no longer line up with the bodies so fall back on their current positions
+        if (interpolation.generation != bodyIndexGeneration || interpolation.count != rbs.count + kbs.count) {
+            int rigid = MIN(rbs.count, count);
+
+            for (int i = 0; i < rigid; ++i) { positions[i] = rbs.rigidBodies[i]->pos; }
+            for (int i = rigid; i < count; ++i) { positions[i] = kbs.kinematicBodies[i - rbs.count]->pos; }
+
+            return count;
+        }
+
+        ZMath::Vec2D const* prev = interpolation.prev;
+        ZMath::Vec2D const* curr = interpolation.curr;
+
+        for (int i = 0; i < count; ++i) { positions[i] = prev[i] + (curr[i] - prev[i]) * alpha; }
+
+        return count;
+    };
+
+
+    // * ===========================
+    // * Continuous Collisions
+    // * ===========================
+
+    // Move a rigid body and its collider.
+    static inline void placeRigidBody(RigidBody2D* rb, ZMath::Vec2D const &pos) {
+        rb->pos = pos;
+
+        if      (rb->colliderType == RIGID_CIRCLE_COLLIDER) { rb->collider.circle.c = pos; }
+        else if (rb->colliderType == RIGID_AABB_COLLIDER)   { rb->collider.aabb.pos = pos; }
+        else if (rb->colliderType == RIGID_BOX2D_COLLIDER)  { rb->collider.box.pos = pos;  }
+
+        rb->updateBounds();
+    };
+
+    void Handler::updateBullet(RigidBody2D* rb, float dt) {
+        // ? Integrate as normal, then sweep the collider from where it started to where it ended up.
+        // ? If it hits something on the way, stop it at the time of impact, reflect its velocity off of the surface,
+        // ?  and spend the rest of the step moving along the new velocity. Only the bullet is substepped.
+        // ? The sweeps are exact since a capped sweep can step over a wall thinner than the bullet's steps.
+
+        updateStaticTree();
+
+        ZMath::Vec2D start = rb->pos;
+        rb->update(g, dt);
+        ZMath::Vec2D end = rb->pos;
+
+        for (int i = 0; i < BULLET_SUBSTEPS; ++i) {
+            ZMath::Vec2D disp = end - start;
+            float len = disp.mag();
+
+            if (len == 0.0f) { return; }
+
+            ZMath::Vec2D dir = disp * (1.0f/len);
+            placeRigidBody(rb, start);
+
+            ShapecastHit hit;
+            bool found = Zeta::shapecast(staticTree, rb->colliderType, &rb->collider, dir, len, hit, nullptr, 1);
+            if (found) { len = hit.dist; }
+
+            for (int j = 0; j < kbs.count; ++j) {
+                BodyRef ref = {kbs.kinematicBodies[j], KINEMATIC_BODY};
+                if (kbs.kinematicBodies[j]->sensor) { continue; }
+
+                float dist;
+                ZMath::Vec2D normal;
+
+                if (Zeta::shapecast(ref, rb->colliderType, &rb->collider, dir, len, dist, normal, 1) && dist <= len) {
+                    found = 1;
+                    len = dist;
+
+                    hit.body = ref;
+                    hit.dist = dist;
+                    hit.normal = normal;
+                }
+            }
+
+            if (!found) {
+                placeRigidBody(rb, end);
+                return;
+            }
+
+            // stop at the time of impact and bounce off of the surface
+            placeRigidBody(rb, start + dir * hit.dist);
+
+            float vn = rb->vel * hit.normal;
+            if (vn < 0.0f) { rb->vel -= hit.normal * ((1.0f + rb->cor) * vn); }
+
+            dt *= 1.0f - hit.dist / disp.mag();
+            start = rb->pos;
+            end = start + rb->vel * dt;
+        }
+
+        // out of substeps. Leave the bullet at its last time of impact.
+    };
+
+
+    // * =====================
+    // * World Queries
+    // * =====================
+
+    void Handler::updateStaticTree() {
+        if (!staticTreeDirty) { return; }
+
+        staticTree.clear();
+        for (int i = 0; i < sbs.count; ++i) { staticTree.add({sbs.staticBodies[i], STATIC_BODY}); }
+        staticTree.build();
+
+        staticTreeDirty = 0;
+    };
+
+    void Handler::updateTrees() {
+        updateStaticTree();
+
+        // ? Refitting keeps the hierarchy, so bodies stay grouped with the ones they were near when the tree was built.
+        // ?  Once they drift far enough apart the boxes overlap so much that a rebuild pays for itself.
+        if (!dynamicTreeDirty && dynamicTreeMoved) {
+            float cost = dynamicTree.refit();
+            dynamicTreeDirty = cost > BVH_REFIT_LIMIT*dynamicTree.buildCost;
+        }
+
+        if (dynamicTreeDirty) {
+            dynamicTree.clear();
+            for (int i = 0; i < rbs.count; ++i) { dynamicTree.add({rbs.rigidBodies[i], RIGID_BODY}); }
+            for (int i = 0; i < kbs.count; ++i) { dynamicTree.add({kbs.kinematicBodies[i], KINEMATIC_BODY}); }
+            dynamicTree.build();
+
+            dynamicTreeDirty = 0;
+        }
+
+        dynamicTreeMoved = 0;
+    };
+
+    bool Handler::raycast(Ray2D const &ray, RaycastHit &hit, float maxDist) {
+        updateTrees();
+
+        // the best distance from the static bodies bounds the search through the dynamic bodies
+        bool found = Zeta::raycast(staticTree, ray, maxDist, hit);
+        if (found) { maxDist = hit.dist; }
+
+        return Zeta::raycast(dynamicTree, ray, maxDist, hit) || found;
+    };
+
+    bool Handler::raycastAny(Ray2D const &ray, RaycastHit &hit, float maxDist) {
+        updateTrees();
+        return Zeta::raycast(staticTree, ray, maxDist, hit, 1) || Zeta::raycast(dynamicTree, ray, maxDist, hit, 1);
+    };
+
+    int Handler::raycastAll(Ray2D const &ray, RaycastHit* hits, int capacity, float maxDist) {
+        updateTrees();
+
+        int count = Zeta::raycastAll(staticTree, ray, maxDist, hits, 0, capacity);
+        return Zeta::raycastAll(dynamicTree, ray, maxDist, hits, count, capacity);
+    };
+
+    int Handler::raycast(Ray2D const* rays, int count, RaycastHit* hits, float maxDist) {
+        updateTrees();
+
+        int hitCount = 0;
+        float best[RAY_PACKET_SIZE];
+
+        for (int i = 0; i < count; i += RAY_PACKET_SIZE) {
+            int n = MIN(RAY_PACKET_SIZE, count - i);
+
+            for (int j = 0; j < n; ++j) {
+                best[j] = maxDist;
+                hits[i + j].body.body = nullptr;
+            }
+
+            raycastPacket(staticTree, rays + i, n, best, hits + i);
+            raycastPacket(dynamicTree, rays + i, n, best, hits + i);
+
+            for (int j = 0; j < n; ++j) { if (hits[i + j].body.body) { ++hitCount; } }
+        }
+
+        return hitCount;
+    };
+
+    int Handler::queryAABB(AABB const &aabb, BodyRef* bodies, int capacity) {
+        updateTrees();
+
+        int count = query(staticTree, RIGID_AABB_COLLIDER, &aabb, bodies, 0, capacity);
+        return query(dynamicTree, RIGID_AABB_COLLIDER, &aabb, bodies, count, capacity);
+    };
+
+    int Handler::queryCircle(Circle const &circle, BodyRef* bodies, int capacity) {
+        updateTrees();
+
+        int count = query(staticTree, RIGID_CIRCLE_COLLIDER, &circle, bodies, 0, capacity);
+        return query(dynamicTree, RIGID_CIRCLE_COLLIDER, &circle, bodies, count, capacity);
+    };
+
+    int Handler::queryBox(Box2D const &box, BodyRef* bodies, int capacity) {
+        updateTrees();
+
+        int count = query(staticTree, RIGID_BOX2D_COLLIDER, &box, bodies, 0, capacity);
+        return query(dynamicTree, RIGID_BOX2D_COLLIDER, &box, bodies, count, capacity);
+    };
+
+    // The static tree's hit bounds how far the dynamic tree needs to be swept.
+    static bool shapecastTrees(BVH const &staticTree, BVH const &dynamicTree, int type, void const* shape, ZMath::Vec2D const &dir,
+                               ShapecastHit &hit, float maxDist, void const* ignore) {
+
+        bool found = shapecast(staticTree, type, shape, dir, maxDist, hit, ignore);
+        if (found) { maxDist = hit.dist; }
+
+        return shapecast(dynamicTree, type, shape, dir, maxDist, hit, ignore) || found;
+    };
+
+    bool Handler::shapecast(Circle const &circle, ZMath::Vec2D const &dir, ShapecastHit &hit, float maxDist, void const* ignore) {
+        updateTrees();
+        return shapecastTrees(staticTree, dynamicTree, RIGID_CIRCLE_COLLIDER, &circle, dir, hit, maxDist, ignore);
+    };
+
+    bool Handler::shapecast(AABB const &aabb, ZMath::Vec2D const &dir, ShapecastHit &hit, float maxDist, void const* ignore) {
+        updateTrees();
+        return shapecastTrees(staticTree, dynamicTree, RIGID_AABB_COLLIDER, &aabb, dir, hit, maxDist, ignore);
+    };
+
+    bool Handler::shapecast(Box2D const &box, ZMath::Vec2D const &dir, ShapecastHit &hit, float maxDist, void const* ignore) {
+        updateTrees();
+        return shapecastTrees(staticTree, dynamicTree, RIGID_BOX2D_COLLIDER, &box, dir, hit, maxDist, ignore);
+    };
 }
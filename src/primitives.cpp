@@ -22,15 +22,17 @@ namespace Zeta {
     // Remember to call delete[] on what you assign this to afterwards to free the memory.
     ZMath::Vec2D* AABB::getVertices() const {
         ZMath::Vec2D* v = new ZMath::Vec2D[4];
+        getVertices(v);
+        return v;
+    };
 
+    void AABB::getVertices(ZMath::Vec2D v[4]) const {
         // todo ensure the order is the same as the order OpenGL likes
 
         v[0] = pos - halfsize;
         v[1] = ZMath::Vec2D(pos.x - halfsize.x, pos.y + halfsize.y);
         v[2] = ZMath::Vec2D(pos.x + halfsize.x, pos.y - halfsize.y);
         v[3] = pos + halfsize;
-
-        return v;
     };
 
 
@@ -49,7 +51,11 @@ namespace Zeta {
     // Remeber to use delete[] on the variable you assign this after use to free the memory.
     ZMath::Vec2D* Box2D::getVertices() const {
         ZMath::Vec2D* v = new ZMath::Vec2D[4];
+        getVertices(v);
+        return v;
+    };
 
+    void Box2D::getVertices(ZMath::Vec2D v[4]) const {
         // todo reorder to match OpenGL bindings
 
         v[0] = -halfsize;
@@ -59,7 +65,5 @@ namespace Zeta {
 
         // rotate the vertices
         for (int i = 0; i < 4; ++i) { v[i] = rot * v[i] + pos; }
-        
-        return v;
     };
 }
@@ -0,0 +1,348 @@
+#include <ZETA/recorder.h>
+#include <ZETA/physicshandler.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace Zeta {
+    // * ========================
+    // * Recordings
+    // * ========================
+
+    // Written at the start of every recording.
+    struct RecordingHeader {
+        char magic[4]; // "ZREC"
+        uint32_t version; // RECORDING_VERSION of the writer
+        uint32_t rigidSize; // sizeof(RigidBody2D) of the writer
+        uint32_t staticSize; // sizeof(StaticBody2D) of the writer
+        uint32_t kinematicSize; // sizeof(KinematicBody2D) of the writer
+    };
+
+    // Size of the raw bytes of a body of the given type.
+    static inline size_t bodySize(BodyType type) {
+        switch (type) {
+            case RIGID_BODY: { return sizeof(RigidBody2D); }
+            case STATIC_BODY: { return sizeof(StaticBody2D); }
+            case KINEMATIC_BODY: { return sizeof(KinematicBody2D); }
+        }
+
+        return 0;
+    };
+
+    static inline bool sameSettings(RecordSettings const &a, RecordSettings const &b) {
+        return a.g.x == b.g.x && a.g.y == b.g.y && a.updateStep == b.updateStep && a.stepBudget == b.stepBudget &&
+               a.maxSteps == b.maxSteps && a.stepLimitMode == b.stepLimitMode && a.speculativeContacts == b.speculativeContacts &&
+               a.reorderInterval == b.reorderInterval &&
+               !memcmp(a.lodIntervals, b.lodIntervals, sizeof(a.lodIntervals));
+    };
+
+
+    // * ========================
+    // * Recorder
+    // * ========================
+
+    // Initial size of the buffer in bytes.
+    static const size_t startingBytes = 4096;
+
+    Recorder::Recorder() {
+        data = new char[startingBytes];
+        capacity = startingBytes;
+
+        clear();
+    };
+
+    Recorder::~Recorder() { delete[] data; };
+
+    void Recorder::reserve(size_t n) {
+        if (size + n <= capacity) { return; }
+
+        do { capacity *= 2; } while (size + n > capacity);
+        char* temp = new char[capacity];
+
+        memcpy(temp, data, size);
+
+        delete[] data;
+        data = temp;
+    };
+
+    void Recorder::write(void const* bytes, size_t n) {
+        reserve(n);
+        memcpy(data + size, bytes, n);
+        size += n;
+    };
+
+    void Recorder::clear() {
+        size = 0;
+        hasSettings = 0;
+
+        RecordingHeader header = {{'Z', 'R', 'E', 'C'}, RECORDING_VERSION, sizeof(RigidBody2D), sizeof(StaticBody2D), sizeof(KinematicBody2D)};
+        write(&header, sizeof(RecordingHeader));
+    };
+
+    bool Recorder::save(char const* path) const {
+        FILE* file = fopen(path, "wb");
+        if (!file) { return 0; }
+
+        bool ok = fwrite(data, 1, size, file) == size;
+
+        if (fclose(file)) { ok = 0; }
+        return ok;
+    };
+
+    // ? Each record is a one byte RecordType followed by its payload.
+
+    void Recorder::recordSettings(RecordSettings const &settings) {
+        if (hasSettings && sameSettings(settings, this->settings)) { return; }
+
+        uint8_t type = RECORD_SETTINGS;
+        write(&type, 1);
+        write(&settings, sizeof(RecordSettings));
+
+        this->settings = settings;
+        hasSettings = 1;
+    };
+
+    void Recorder::recordAdd(BodyType bodyType, void const* body) {
+        uint8_t header[2] = {RECORD_ADD_BODY, (uint8_t) bodyType};
+        write(header, 2);
+
+        // the game's pointer means nothing to a replay
+        if (bodyType == RIGID_BODY) {
+            RigidBody2D rb;
+            memcpy(&rb, body, sizeof(RigidBody2D));
+            rb.userData = nullptr;
+
+            write(&rb, sizeof(RigidBody2D));
+            return;
+        }
+
+        write(body, bodySize(bodyType));
+    };
+
+    void Recorder::recordRemove(BodyType bodyType, int index) {
+        uint8_t header[2] = {RECORD_REMOVE_BODY, (uint8_t) bodyType};
+        int32_t i = index;
+
+        write(header, 2);
+        write(&i, sizeof(int32_t));
+    };
+
+    void Recorder::recordDespawn(int index) {
+        uint8_t type = RECORD_DESPAWN_BODY;
+        int32_t i = index;
+
+        write(&type, 1);
+        write(&i, sizeof(int32_t));
+    };
+
+    void Recorder::recordForce(int index, ZMath::Vec2D const &force) {
+        uint8_t type = RECORD_FORCE;
+        int32_t i = index;
+
+        write(&type, 1);
+        write(&i, sizeof(int32_t));
+        write(&force, sizeof(ZMath::Vec2D));
+    };
+
+    void Recorder::recordActiveRegions(ZMath::Vec2D const* mins, ZMath::Vec2D const* maxes, int count) {
+        uint8_t type = RECORD_ACTIVE_REGIONS;
+        int32_t n = count;
+
+        write(&type, 1);
+        write(&n, sizeof(int32_t));
+
+        for (int i = 0; i < count; ++i) {
+            write(mins + i, sizeof(ZMath::Vec2D));
+            write(maxes + i, sizeof(ZMath::Vec2D));
+        }
+    };
+
+    void Recorder::recordUpdate(float dt) {
+        uint8_t type = RECORD_UPDATE;
+
+        write(&type, 1);
+        write(&dt, sizeof(float));
+    };
+
+
+    // * ========================
+    // * Record Reader
+    // * ========================
+
+    bool RecordReader::open(void const* data, size_t size) {
+        this->data = (char const*) data;
+        this->size = size;
+        offset = 0;
+
+        // the format stores everything as it is laid out in memory, which is only little-endian on little-endian machines
+        uint16_t endian = 1;
+        if (!*((uint8_t*) &endian) || size < sizeof(RecordingHeader)) { return 0; }
+
+        RecordingHeader header;
+        memcpy(&header, data, sizeof(RecordingHeader));
+
+        if (memcmp(header.magic, "ZREC", 4) || header.version != RECORDING_VERSION || header.rigidSize != sizeof(RigidBody2D) ||
+            header.staticSize != sizeof(StaticBody2D) || header.kinematicSize != sizeof(KinematicBody2D)) { return 0; }
+
+        offset = sizeof(RecordingHeader);
+        return 1;
+    };
+
+    bool RecordReader::next(Record &record) {
+        // read n bytes into out if they are there
+        auto read = [&](void* out, size_t n) {
+            if (offset + n > size) { return false; }
+
+            memcpy(out, data + offset, n);
+            offset += n;
+            return true;
+        };
+
+        uint8_t type;
+        if (!read(&type, 1)) { return 0; }
+
+        record.type = (RecordType) type;
+
+        switch (record.type) {
+            case RECORD_SETTINGS: { return read(&record.settings, sizeof(RecordSettings)); }
+
+            case RECORD_ADD_BODY: {
+                uint8_t bodyType;
+                if (!read(&bodyType, 1) || bodyType > KINEMATIC_BODY) { return 0; }
+
+                record.bodyType = (BodyType) bodyType;
+                record.body = data + offset;
+
+                size_t n = bodySize(record.bodyType);
+                if (offset + n > size) { return 0; }
+
+                offset += n;
+                return 1;
+            }
+
+            case RECORD_REMOVE_BODY: {
+                uint8_t bodyType;
+                int32_t index;
+                if (!read(&bodyType, 1) || bodyType > KINEMATIC_BODY || !read(&index, sizeof(int32_t))) { return 0; }
+
+                record.bodyType = (BodyType) bodyType;
+                record.index = index;
+                return 1;
+            }
+
+            case RECORD_FORCE: {
+                int32_t index;
+                if (!read(&index, sizeof(int32_t)) || !read(&record.force, sizeof(ZMath::Vec2D))) { return 0; }
+
+                record.index = index;
+                return 1;
+            }
+
+            case RECORD_ACTIVE_REGIONS: {
+                int32_t count;
+                if (!read(&count, sizeof(int32_t)) || count < 0) { return 0; }
+
+                size_t n = (size_t) count * 2 * sizeof(ZMath::Vec2D);
+                if (offset + n > size) { return 0; }
+
+                record.index = count;
+                record.regions = data + offset;
+                offset += n;
+                return 1;
+            }
+
+            case RECORD_UPDATE: { return read(&record.dt, sizeof(float)); }
+
+            case RECORD_DESPAWN_BODY: {
+                int32_t index;
+                if (!read(&index, sizeof(int32_t))) { return 0; }
+
+                record.index = index;
+                return 1;
+            }
+        }
+
+        return 0;
+    };
+
+
+    // * ========================
+    // * Replaying
+    // * ========================
+
+    // Copy a body out of the recording onto the heap since the handler takes ownership of it.
+    template <typename T>
+    static T* copyBody(void const* bytes) {
+        T* body = new T();
+        memcpy((void*) body, bytes, sizeof(T));
+        return body;
+    };
+
+    int replayRecord(Handler &handler, Record const &record) {
+        switch (record.type) {
+            case RECORD_SETTINGS: {
+                RecordSettings const &settings = record.settings;
+
+                handler.g = settings.g;
+                handler.stepBudget = settings.stepBudget;
+                handler.maxSteps = settings.maxSteps;
+                handler.stepLimitMode = (StepLimitMode) settings.stepLimitMode;
+                handler.speculativeContacts = settings.speculativeContacts;
+                handler.reorderInterval = settings.reorderInterval;
+
+                for (int i = 0; i < LOD_TIERS; ++i) { handler.lodIntervals[i] = settings.lodIntervals[i]; }
+                return 0;
+            }
+
+            case RECORD_ADD_BODY: {
+                switch (record.bodyType) {
+                    case RIGID_BODY: { handler.addRigidBody(copyBody<RigidBody2D>(record.body)); break; }
+                    case STATIC_BODY: { handler.addStaticBody(copyBody<StaticBody2D>(record.body)); break; }
+                    case KINEMATIC_BODY: { handler.addKinematicBody(copyBody<KinematicBody2D>(record.body)); break; }
+                }
+
+                return 0;
+            }
+
+            case RECORD_REMOVE_BODY: {
+                switch (record.bodyType) {
+                    case RIGID_BODY: { handler.removeRigidBody(handler.getRigidBody(record.index)); break; }
+                    case STATIC_BODY: { handler.removeStaticBody(handler.getStaticBody(record.index)); break; }
+                    case KINEMATIC_BODY: { handler.removeKinematicBody(handler.getKinematicBody(record.index)); break; }
+                }
+
+                return 0;
+            }
+
+            case RECORD_DESPAWN_BODY: {
+                handler.despawnRigidBody(handler.getRigidBody(record.index));
+                return 0;
+            }
+
+            case RECORD_FORCE: {
+                if (record.index < handler.getRigidBodyCount()) { handler.getRigidBody(record.index)->netForce = record.force; }
+                return 0;
+            }
+
+            case RECORD_ACTIVE_REGIONS: {
+                std::vector<AABB> regions;
+
+                for (int i = 0; i < record.index; ++i) {
+                    ZMath::Vec2D bounds[2];
+                    memcpy(bounds, (char const*) record.regions + i*sizeof(bounds), sizeof(bounds));
+                    regions.push_back(AABB(bounds[0], bounds[1]));
+                }
+
+                handler.setActiveRegions(regions.data(), record.index);
+                return 0;
+            }
+
+            case RECORD_UPDATE: {
+                float dt = record.dt;
+                return handler.update(dt);
+            }
+        }
+
+        return 0;
+    };
+}
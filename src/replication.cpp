@@ -0,0 +1,310 @@
+#include <ZETA/replication.h>
+#include <cmath>
+#include <cstring>
+
+namespace Zeta {
+    // * ========================
+    // * Bit Packing
+    // * ========================
+
+    // Writes bits into a byte buffer, least significant bit first.
+    struct BitWriter {
+        uint8_t* data;
+        size_t capacity;
+        size_t size = 0; // bytes flushed so far
+        uint64_t scratch = 0; // bits not flushed yet
+        int bits = 0; // number of bits in scratch
+        bool overflow = 0;
+
+        inline BitWriter(void* data, size_t capacity) : data((uint8_t*) data), capacity(capacity) {};
+
+        // Write the low n bits of value (n <= 32).
+        inline void write(uint32_t value, int n) {
+            if (n < 32) { value &= (1u << n) - 1; }
+
+            scratch |= (uint64_t) value << bits;
+            bits += n;
+
+            if (bits >= 32) {
+                if (size + 4 > capacity) { overflow = 1; }
+                else { for (int i = 0; i < 4; ++i) { data[size++] = (uint8_t) (scratch >> 8*i); } }
+
+                scratch >>= 32;
+                bits -= 32;
+            }
+        };
+
+        // Flush the remaining bits. Returns the total number of bytes written or 0 on overflow.
+        inline size_t finish() {
+            for (; bits > 0; bits -= 8, scratch >>= 8) {
+                if (size == capacity) { overflow = 1; break; }
+                data[size++] = (uint8_t) scratch;
+            }
+
+            return overflow ? 0 : size;
+        };
+    };
+
+    // Reads bits written by a BitWriter.
+    struct BitReader {
+        uint8_t const* data;
+        size_t size;
+        size_t offset = 0; // next byte to load
+        uint64_t scratch = 0;
+        int bits = 0;
+        bool overflow = 0;
+
+        inline BitReader(void const* data, size_t size) : data((uint8_t const*) data), size(size) {};
+
+        // Read n bits (n <= 32). Reading past the end sets overflow and returns 0 bits.
+        inline uint32_t read(int n) {
+            while (bits < n) {
+                if (offset == size) {
+                    overflow = 1;
+                    return 0;
+                }
+
+                scratch |= (uint64_t) data[offset++] << bits;
+                bits += 8;
+            }
+
+            uint32_t value = (uint32_t) (n < 32 ? scratch & ((1ull << n) - 1) : scratch);
+            scratch >>= n;
+            bits -= n;
+
+            return value;
+        };
+    };
+
+    // ? Values are written as a 2 bit size class followed by that many bits. Class 0 means the value is 0.
+    static const int VALUE_BITS[4] = {0, 6, 14, 32};
+
+    static inline void writeValue(BitWriter &writer, uint32_t value) {
+        int sizeClass = !value ? 0 : value < (1u << 6) ? 1 : value < (1u << 14) ? 2 : 3;
+
+        writer.write(sizeClass, 2);
+        if (sizeClass) { writer.write(value, VALUE_BITS[sizeClass]); }
+    };
+
+    static inline uint32_t readValue(BitReader &reader) {
+        int sizeClass = reader.read(2);
+        return sizeClass ? reader.read(VALUE_BITS[sizeClass]) : 0;
+    };
+
+    // Map signed values to unsigned so small negative deltas stay small.
+    static inline uint32_t zigzag(int32_t n) { return ((uint32_t) n << 1) ^ (uint32_t) (n >> 31); };
+    static inline int32_t unzigzag(uint32_t n) { return (int32_t) (n >> 1) ^ -(int32_t) (n & 1); };
+
+    // Make sure a list of states can hold n states. The existing states are kept.
+    static void reserveStates(QuantizedStates &list, int n) {
+        if (n <= list.capacity) { return; }
+
+        int capacity = list.capacity ? list.capacity : 64;
+        while (capacity < n) { capacity *= 2; }
+
+        QuantizedState* temp = new QuantizedState[capacity];
+        if (list.count) { memcpy(temp, list.states, list.count*sizeof(QuantizedState)); }
+
+        delete[] list.states;
+        list.states = temp;
+        list.capacity = capacity;
+    };
+
+    // Quantize a value, clamping it so the deltas between any two values cannot overflow.
+    static inline int32_t quantize(float value, float invPrecision) {
+        float q = floorf(value*invPrecision + 0.5f);
+        return (int32_t) (q > 1073741823.0f ? 1073741823.0f : (q < -1073741823.0f ? -1073741823.0f : q));
+    };
+
+
+    // * ========================
+    // * Replication Encoder
+    // * ========================
+
+    ReplicationEncoder::ReplicationEncoder(float posPrecision, float velPrecision)
+        : invPosPrecision(1.0f/posPrecision), invVelPrecision(1.0f/velPrecision) {};
+
+    ReplicationEncoder::~ReplicationEncoder() {
+        delete[] current.states;
+
+        for (int i = 0; i < clients.count; ++i) { delete[] clients.baselines[i].states; }
+        delete[] clients.baselines;
+        delete[] clients.active;
+    };
+
+    int ReplicationEncoder::addClient() {
+        // reuse a removed client's slot
+        for (int i = 0; i < clients.count; ++i) {
+            if (!clients.active[i]) {
+                clients.active[i] = 1;
+                clients.baselines[i].count = 0;
+                return i;
+            }
+        }
+
+        if (clients.count == clients.capacity) {
+            clients.capacity = clients.capacity ? 2*clients.capacity : 4;
+
+            QuantizedStates* temp1 = new QuantizedStates[clients.capacity];
+            bool* temp2 = new bool[clients.capacity];
+
+            for (int i = 0; i < clients.count; ++i) {
+                temp1[i] = clients.baselines[i];
+                temp2[i] = clients.active[i];
+            }
+
+            delete[] clients.baselines;
+            delete[] clients.active;
+
+            clients.baselines = temp1;
+            clients.active = temp2;
+        }
+
+        clients.baselines[clients.count] = QuantizedStates();
+        clients.active[clients.count] = 1;
+
+        return clients.count++;
+    };
+
+    void ReplicationEncoder::removeClient(int client) {
+        clients.active[client] = 0;
+        clients.baselines[client].count = 0;
+    };
+
+    void ReplicationEncoder::resetClient(int client) { clients.baselines[client].count = 0; };
+
+    void ReplicationEncoder::capture(Handler const &handler) {
+        int count = handler.getRigidBodyCount();
+
+        // the bodies the clients have are now at different indices
+        if (captured && generation != handler.getBodyIndexGeneration()) {
+            for (int i = 0; i < clients.count; ++i) { clients.baselines[i].count = 0; }
+        }
+
+        generation = handler.getBodyIndexGeneration();
+        captured = 1;
+
+        reserveStates(current, count);
+        current.count = count;
+
+        for (int i = 0; i < count; ++i) {
+            RigidBody2D const* rb = handler.getRigidBody(i);
+            QuantizedState &state = current.states[i];
+
+            state.px = quantize(rb->pos.x, invPosPrecision);
+            state.py = quantize(rb->pos.y, invPosPrecision);
+            state.vx = quantize(rb->vel.x, invVelPrecision);
+            state.vy = quantize(rb->vel.y, invVelPrecision);
+        }
+    };
+
+    size_t ReplicationEncoder::encode(int client, void* buffer, size_t capacity) {
+        QuantizedStates &baseline = clients.baselines[client];
+        static const QuantizedState zero = {0, 0, 0, 0};
+
+        // ? Packet: body count (32 bits), full resend flag (1 bit), number of changed bodies, then for each changed body the
+        // ?  number of unchanged bodies skipped since the last one followed by the deltas of its position and velocity.
+        // ? A client without a baseline gets a full resend, which the decoder applies on top of zeroed states.
+
+        int changed = 0;
+
+        for (int i = 0; i < current.count; ++i) {
+            QuantizedState const &base = i < baseline.count ? baseline.states[i] : zero;
+            changed += !!memcmp(&current.states[i], &base, sizeof(QuantizedState));
+        }
+
+        BitWriter writer(buffer, capacity);
+        writer.write(current.count, 32);
+        writer.write(!baseline.count, 1);
+        writeValue(writer, changed);
+
+        int last = -1;
+
+        for (int i = 0; i < current.count && changed; ++i) {
+            QuantizedState const &state = current.states[i];
+            QuantizedState const &base = i < baseline.count ? baseline.states[i] : zero;
+
+            if (!memcmp(&state, &base, sizeof(QuantizedState))) { continue; }
+
+            writeValue(writer, i - last - 1);
+            writeValue(writer, zigzag((int32_t) ((uint32_t) state.px - (uint32_t) base.px)));
+            writeValue(writer, zigzag((int32_t) ((uint32_t) state.py - (uint32_t) base.py)));
+            writeValue(writer, zigzag((int32_t) ((uint32_t) state.vx - (uint32_t) base.vx)));
+            writeValue(writer, zigzag((int32_t) ((uint32_t) state.vy - (uint32_t) base.vy)));
+
+            last = i;
+            --changed;
+        }
+
+        size_t size = writer.finish();
+        if (!size) { return 0; }
+
+        // the client now has the captured state
+        reserveStates(baseline, current.count);
+        memcpy(baseline.states, current.states, current.count*sizeof(QuantizedState));
+        baseline.count = current.count;
+
+        return size;
+    };
+
+
+    // * ========================
+    // * Replication Decoder
+    // * ========================
+
+    ReplicationDecoder::ReplicationDecoder(float posPrecision, float velPrecision)
+        : posPrecision(posPrecision), velPrecision(velPrecision) {};
+
+    ReplicationDecoder::~ReplicationDecoder() {
+        delete[] states.states;
+        delete[] scratch.states;
+    };
+
+    bool ReplicationDecoder::decode(void const* buffer, size_t size) {
+        BitReader reader(buffer, size);
+
+        uint32_t count = reader.read(32);
+        bool full = reader.read(1);
+        uint32_t changed = readValue(reader);
+
+        if (reader.overflow || count > (uint32_t) INT32_MAX || changed > count) { return 0; }
+
+        // ? Decode into scratch so a malformed packet leaves the current state alone.
+
+        reserveStates(scratch, count);
+
+        int kept = full ? 0 : MIN(states.count, (int) count);
+        if (kept) { memcpy(scratch.states, states.states, kept*sizeof(QuantizedState)); }
+        if ((int) count > kept) { memset(scratch.states + kept, 0, (count - kept)*sizeof(QuantizedState)); }
+
+        scratch.count = count;
+        uint64_t i = (uint64_t) -1;
+
+        for (uint32_t n = 0; n < changed; ++n) {
+            i += (uint64_t) readValue(reader) + 1;
+            if (reader.overflow || i >= count) { return 0; }
+
+            QuantizedState &state = scratch.states[i];
+
+            state.px = (int32_t) ((uint32_t) state.px + (uint32_t) unzigzag(readValue(reader)));
+            state.py = (int32_t) ((uint32_t) state.py + (uint32_t) unzigzag(readValue(reader)));
+            state.vx = (int32_t) ((uint32_t) state.vx + (uint32_t) unzigzag(readValue(reader)));
+            state.vy = (int32_t) ((uint32_t) state.vy + (uint32_t) unzigzag(readValue(reader)));
+        }
+
+        if (reader.overflow) { return 0; }
+
+        QuantizedStates temp = states;
+        states = scratch;
+        scratch = temp;
+
+        return 1;
+    };
+
+    void ReplicationDecoder::getState(int i, ZMath::Vec2D &pos, ZMath::Vec2D &vel) const {
+        QuantizedState const &state = states.states[i];
+
+        pos.set(state.px*posPrecision, state.py*posPrecision);
+        vel.set(state.vx*velPrecision, state.vy*velPrecision);
+    };
+}
@@ -0,0 +1,210 @@
+#include <ZETA/scene.h>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Zeta {
+    // * ========================
+    // * Scene File Format
+    // * ========================
+
+    static_assert(std::is_trivially_copyable<StaticBody2D>::value, "StaticBody2D must be trivially copyable to be stored in a scene.");
+    static_assert(std::is_trivially_copyable<BVHNode>::value, "BVHNode must be trivially copyable to be stored in a scene.");
+
+    // Align file offsets to a cache line so everything in the mapping is suitably aligned.
+    static const uint64_t SCENE_ALIGNMENT = 64;
+
+    static inline uint64_t alignOffset(uint64_t offset) { return (offset + SCENE_ALIGNMENT - 1) & ~(SCENE_ALIGNMENT - 1); };
+
+    // The format stores everything as it is laid out in memory, which is only little-endian on little-endian machines.
+    static inline bool isLittleEndian() {
+        uint16_t x = 1;
+        return *((uint8_t*) &x);
+    };
+
+    SceneFile::~SceneFile() { close(); };
+
+    void SceneFile::close() {
+        if (!data) { return; }
+
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle((HANDLE) mapping);
+        CloseHandle((HANDLE) file);
+
+        mapping = nullptr;
+        file = nullptr;
+#else
+        munmap(data, size);
+#endif
+
+        data = nullptr;
+        size = 0;
+    };
+
+    bool SceneFile::open(char const* path) {
+        close();
+        if (!isLittleEndian()) { return 0; }
+
+#ifdef _WIN32
+        HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) { return 0; }
+
+        LARGE_INTEGER fileSize;
+        HANDLE m = nullptr;
+        void* view = nullptr;
+
+        if (GetFileSizeEx(f, &fileSize) && fileSize.QuadPart >= (LONGLONG) sizeof(SceneHeader)) {
+            m = CreateFileMappingA(f, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (m) { view = MapViewOfFile(m, FILE_MAP_COPY, 0, 0, 0); }
+        }
+
+        if (!view) {
+            if (m) { CloseHandle(m); }
+            CloseHandle(f);
+            return 0;
+        }
+
+        data = view;
+        size = (size_t) fileSize.QuadPart;
+        file = f;
+        mapping = m;
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) { return 0; }
+
+        struct stat st;
+        if (fstat(fd, &st) || st.st_size < (off_t) sizeof(SceneHeader)) {
+            ::close(fd);
+            return 0;
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        void* view = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (view == MAP_FAILED) { return 0; }
+
+        data = view;
+        size = st.st_size;
+#endif
+
+        // * Validate the file before anything reads from it.
+
+        SceneHeader const* header = getHeader();
+
+        bool valid = !memcmp(header->magic, "ZSCN", 4) && header->version == SCENE_VERSION &&
+                     header->bodySize == sizeof(StaticBody2D) && header->nodeSize == sizeof(BVHNode) &&
+                     header->size == size && header->itemCount <= header->bodyCount &&
+                     header->bodiesOffset + (uint64_t) header->bodyCount * sizeof(StaticBody2D) <= size &&
+                     header->boundsOffset + (uint64_t) header->itemCount * 2 * sizeof(ZMath::Vec2D) <= size &&
+                     header->nodesOffset + (uint64_t) header->nodeCount * sizeof(BVHNode) <= size &&
+                     header->nodeCount <= 2 * (uint64_t) header->itemCount &&
+                     (header->nodeCount || !header->itemCount);
+
+        // the nodes are used without any bounds checks so make sure every index stays in range
+        BVHNode const* nodes = getNodes();
+
+        for (uint32_t i = 0; i < header->nodeCount && valid; ++i) {
+            if (nodes[i].count) { valid = nodes[i].count > 0 && nodes[i].left >= 0 && (uint64_t) nodes[i].left + nodes[i].count <= header->itemCount; }
+            else { valid = nodes[i].left > (int) i && (uint64_t) nodes[i].left + 1 < header->nodeCount; }
+        }
+
+        if (!valid) { close(); }
+        return valid;
+    };
+
+    bool writeScene(char const* path, StaticBody2D* const* bodies, int count, BVH const &tree) {
+        if (!isLittleEndian()) { return 0; }
+
+        SceneHeader header;
+        memcpy(header.magic, "ZSCN", 4);
+
+        header.version = SCENE_VERSION;
+        header.bodySize = sizeof(StaticBody2D);
+        header.nodeSize = sizeof(BVHNode);
+        header.bodyCount = count;
+        header.itemCount = tree.itemCount;
+        header.nodeCount = tree.nodeCount;
+        header.reserved = 0;
+
+        header.bodiesOffset = alignOffset(sizeof(SceneHeader));
+        header.boundsOffset = alignOffset(header.bodiesOffset + (uint64_t) count * sizeof(StaticBody2D));
+        header.nodesOffset = alignOffset(header.boundsOffset + (uint64_t) tree.itemCount * 2 * sizeof(ZMath::Vec2D));
+        header.size = header.nodesOffset + (uint64_t) tree.nodeCount * sizeof(BVHNode);
+
+        // ? The scene is written next to path and moved over it at the end. Truncating a file in place would pull the
+        // ?  pages out from under any handler that has it mapped (including the one saving, when it loaded from path).
+
+        size_t length = strlen(path);
+        char* temp = new char[length + 5];
+        memcpy(temp, path, length);
+        memcpy(temp + length, ".tmp", 5);
+
+        FILE* file = fopen(temp, "wb");
+
+        if (!file) {
+            delete[] temp;
+            return 0;
+        }
+
+        static const char padding[SCENE_ALIGNMENT] = {};
+        uint64_t written = 0;
+        bool ok = 1;
+
+        // write bytes and keep track of the offset
+        auto write = [&](void const* bytes, size_t n) {
+            ok = ok && fwrite(bytes, 1, n, file) == n;
+            written += n;
+        };
+
+        auto pad = [&](uint64_t offset) { write(padding, offset - written); };
+
+        write(&header, sizeof(SceneHeader));
+
+        // ? The items of the tree come first in the order the tree stores them, so item i is body i when loading.
+        // ? Bodies without a collider are not in the tree and go after them.
+
+        pad(header.bodiesOffset);
+        for (int i = 0; i < tree.itemCount; ++i) { write(tree.items[i].ref.body, sizeof(StaticBody2D)); }
+
+        for (int i = 0; i < count; ++i) {
+            if (bodies[i]->colliderType == STATIC_NONE) { write(bodies[i], sizeof(StaticBody2D)); }
+        }
+
+        pad(header.boundsOffset);
+
+        for (int i = 0; i < tree.itemCount; ++i) {
+            write(&tree.items[i].min, sizeof(ZMath::Vec2D));
+            write(&tree.items[i].max, sizeof(ZMath::Vec2D));
+        }
+
+        pad(header.nodesOffset);
+        write(tree.nodes, (size_t) tree.nodeCount * sizeof(BVHNode));
+
+        ok = ok && written == header.size;
+
+        if (fclose(file)) { ok = 0; }
+
+#ifdef _WIN32
+        // fails if the old file is still mapped, which leaves it untouched
+        ok = ok && MoveFileExA(temp, path, MOVEFILE_REPLACE_EXISTING);
+#else
+        ok = ok && !rename(temp, path);
+#endif
+
+        if (!ok) { remove(temp); }
+
+        delete[] temp;
+        return ok;
+    };
+}
@@ -0,0 +1,162 @@
+#include <ZETA/worldbatch.h>
+#include <algorithm>
+#include <chrono>
+
+namespace Zeta {
+    // * =====================
+    // * World Batch
+    // * =====================
+
+    WorldBatch::WorldBatch(int threads) : next(0) {
+        if (threads <= 0) { threads = std::thread::hardware_concurrency(); }
+        if (threads <= 0) { threads = 1; } // hardware_concurrency can fail and return 0
+
+        // the calling thread takes part in every update so it counts as one of the threads
+        workerCount = threads - 1;
+
+        if (workerCount) {
+            workers = new std::thread[workerCount];
+            for (int i = 0; i < workerCount; ++i) { workers[i] = std::thread(&WorldBatch::workerLoop, this); }
+        }
+
+        worlds.capacity = halfStartingSlots;
+        worlds.handlers = new Handler*[worlds.capacity];
+        worlds.accumulators = new float[worlds.capacity];
+        worlds.times = new float[worlds.capacity];
+        worlds.steps = new int[worlds.capacity];
+        worlds.order = new int[worlds.capacity];
+        worlds.bodies = new int[worlds.capacity];
+    };
+
+    WorldBatch::~WorldBatch() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = 1;
+        }
+
+        start.notify_all();
+
+        for (int i = 0; i < workerCount; ++i) { workers[i].join(); }
+        delete[] workers;
+
+        for (int i = 0; i < worlds.count; ++i) { delete worlds.handlers[i]; }
+
+        delete[] worlds.handlers;
+        delete[] worlds.accumulators;
+        delete[] worlds.times;
+        delete[] worlds.steps;
+        delete[] worlds.order;
+        delete[] worlds.bodies;
+    };
+
+    int WorldBatch::addWorld(Handler* handler) {
+        if (worlds.count == worlds.capacity) {
+            worlds.capacity *= 2;
+
+            Handler** handlers = new Handler*[worlds.capacity];
+            float* accumulators = new float[worlds.capacity];
+            float* times = new float[worlds.capacity];
+            int* steps = new int[worlds.capacity];
+
+            for (int i = 0; i < worlds.count; ++i) {
+                handlers[i] = worlds.handlers[i];
+                accumulators[i] = worlds.accumulators[i];
+                times[i] = worlds.times[i];
+                steps[i] = worlds.steps[i];
+            }
+
+            delete[] worlds.handlers;
+            delete[] worlds.accumulators;
+            delete[] worlds.times;
+            delete[] worlds.steps;
+            delete[] worlds.order;
+            delete[] worlds.bodies;
+
+            worlds.handlers = handlers;
+            worlds.accumulators = accumulators;
+            worlds.times = times;
+            worlds.steps = steps;
+            worlds.order = new int[worlds.capacity]; // rebuilt every update
+            worlds.bodies = new int[worlds.capacity]; // rebuilt every update
+        }
+
+        worlds.handlers[worlds.count] = handler;
+        worlds.accumulators[worlds.count] = 0.0f;
+        worlds.times[worlds.count] = 0.0f;
+        worlds.steps[worlds.count] = 0;
+
+        return worlds.count++;
+    };
+
+    void WorldBatch::work() {
+        for (int i = next.fetch_add(1, std::memory_order_relaxed); i < worlds.count; i = next.fetch_add(1, std::memory_order_relaxed)) {
+            int world = worlds.order[i];
+            worlds.accumulators[world] += stepDt;
+
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            worlds.steps[world] = worlds.handlers[world]->update(worlds.accumulators[world]);
+            worlds.times[world] = std::chrono::duration<float>(std::chrono::steady_clock::now() - begin).count();
+        }
+    };
+
+    void WorldBatch::workerLoop() {
+        unsigned int seen = 0;
+
+        while (1) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start.wait(lock, [&] { return stopping || generation != seen; });
+
+                if (stopping) { return; }
+                seen = generation;
+            }
+
+            work();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++finished;
+            }
+
+            done.notify_one();
+        }
+    };
+
+    void WorldBatch::update(float dt) {
+        if (!worlds.count) { return; }
+
+        // ? Hand the worlds out from most to least bodies (longest processing time first).
+        // ? The big worlds get started early and the small ones fill in the gaps at the end.
+
+        int* bodies = worlds.bodies;
+
+        for (int i = 0; i < worlds.count; ++i) {
+            Handler const* handler = worlds.handlers[i];
+
+            worlds.order[i] = i;
+            bodies[i] = handler->getRigidBodyCount() + handler->getKinematicBodyCount() + handler->getStaticBodyCount();
+        }
+
+        std::stable_sort(worlds.order, worlds.order + worlds.count, [bodies](int a, int b) { return bodies[a] > bodies[b]; });
+
+        stepDt = dt;
+        next.store(0, std::memory_order_relaxed);
+
+        if (workerCount) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished = 0;
+                ++generation;
+            }
+
+            start.notify_all();
+        }
+
+        work();
+
+        if (workerCount) {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&] { return finished == workerCount; });
+        }
+    };
+}
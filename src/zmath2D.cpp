@@ -124,8 +124,8 @@ namespace ZMath {
     void rotate(Vec2D &point, Vec2D const &origin, float angle) {
         float x = point.x - origin.x, y = point.y - origin.y;
 
-        float c = cosf(TORADIANS(angle));
-        float s = sinf(TORADIANS(angle));
+        float s, c;
+        sinCos(angle, s, c);
 
         // compute the new point
         point.x = x*c - y*s + origin.x;
@@ -146,6 +146,34 @@ namespace ZMath {
     // * Clamp a Vec2D between a min and max vector.
     Vec2D clamp(const Vec2D &n, const Vec2D &min, const Vec2D &max) { return Vec2D(MAX(MIN(n.x, max.x), min.x), MAX(MIN(n.y, max.y), min.y)); };
 
+    // * Compute the sine and cosine of an angle in degrees.
+    void sinCos(float degrees, float &s, float &c) {
+#ifdef ZETA_DETERMINISTIC
+        // ? sinf and cosf give different results between C runtimes so use polynomials (from Cephes) built only from
+        // ?  operations IEEE 754 requires to be correctly rounded.
+        // ? Reducing the range in degrees keeps it exact enough: fmodf is exact and multiples of 90 are representable.
+
+        float r = fmodf(degrees, 360.0f);
+        int q = (int) floorf(r/90.0f + 0.5f); // nearest multiple of 90 degrees
+        float x = (r - q*90.0f) * 0.0174532925f; // radians in [-pi/4, pi/4]
+        float x2 = x*x;
+
+        float sx = x + x*x2*(-1.6666654611e-1f + x2*(8.3321608736e-3f + x2*-1.9515295891e-4f));
+        float cx = 1.0f - 0.5f*x2 + x2*x2*(4.166664568298827e-2f + x2*(-1.388731625493765e-3f + x2*2.443315711809948e-5f));
+
+        // rotate by the quadrant (q & 3 maps negative quadrants correctly)
+        switch (q & 3) {
+            case 0: { s = sx; c = cx; break; }
+            case 1: { s = cx; c = -sx; break; }
+            case 2: { s = -sx; c = -cx; break; }
+            case 3: { s = -cx; c = sx; break; }
+        }
+#else
+        s = sinf(TORADIANS(degrees));
+        c = cosf(TORADIANS(degrees));
+#endif
+    };
+
 
     // * ===============
     // * Mat2D Stuff
@@ -156,14 +184,6 @@ namespace ZMath {
         c2 = Vec2D(0, 1);
     };
 
-    // Create a 2D matrix from another 2D matrix.
-    Mat2D::Mat2D (const Mat2D &mat) {
-        c1.x = mat.c1.x;
-        c1.y = mat.c1.y;
-        c2.x = mat.c2.x;
-        c2.y = mat.c2.y;
-    };
-
     // Create a 2D matrix from 2 column vectors.
     Mat2D::Mat2D (const Vec2D &col1, const Vec2D &col2) {
         c1.x = col1.x;
@@ -0,0 +1,116 @@
+// Headless replay of a recording made with Zeta::Recorder.
+// Re-runs every call to update as fast as possible and reports how long each one took so slow frames can be profiled offline.
+//
+// Usage: replay <recording> [number of slowest updates to list]
+
+#include <ZETA/physicshandler.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Zeta;
+
+// Timing of a single call to update.
+struct UpdateTiming {
+    double ms;
+    int index; // which call to update this was
+    int steps; // number of steps it ran
+    int rigidBodies, staticBodies, kinematicBodies;
+};
+
+// Read a whole file into memory.
+static bool readFile(char const* path, std::vector<char> &out) {
+    FILE* file = fopen(path, "rb");
+    if (!file) { return 0; }
+
+    char buffer[1 << 16];
+    size_t n;
+
+    while ((n = fread(buffer, 1, sizeof(buffer), file))) { out.insert(out.end(), buffer, buffer + n); }
+
+    fclose(file);
+    return 1;
+};
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Usage: %s <recording> [number of slowest updates to list]\n", argv[0]);
+        return 1;
+    }
+
+    int top = argc > 2 ? atoi(argv[2]) : 10;
+
+    std::vector<char> data;
+    if (!readFile(argv[1], data)) {
+        printf("Could not read %s\n", argv[1]);
+        return 1;
+    }
+
+    RecordReader reader;
+    Record record;
+
+    if (!reader.open(data.data(), data.size()) || !reader.next(record) || record.type != RECORD_SETTINGS) {
+        printf("%s is not a recording made by a compatible build\n", argv[1]);
+        return 1;
+    }
+
+    Handler handler(record.settings.g, record.settings.updateStep);
+    replayRecord(handler, record);
+
+    std::vector<UpdateTiming> timings;
+    int totalSteps = 0;
+
+    // * Replay every record.
+
+    while (reader.next(record)) {
+        if (record.type != RECORD_UPDATE) {
+            replayRecord(handler, record);
+            continue;
+        }
+
+        UpdateTiming timing;
+        timing.index = timings.size();
+        timing.rigidBodies = handler.getRigidBodyCount();
+        timing.staticBodies = handler.getStaticBodyCount();
+        timing.kinematicBodies = handler.getKinematicBodyCount();
+
+        auto start = std::chrono::steady_clock::now();
+        timing.steps = replayRecord(handler, record);
+        timing.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        totalSteps += timing.steps;
+        timings.push_back(timing);
+    }
+
+    if (timings.empty()) {
+        printf("The recording does not contain any updates\n");
+        return 0;
+    }
+
+    // * Report the stats.
+
+    double total = 0.0;
+    for (UpdateTiming const &timing : timings) { total += timing.ms; }
+
+    std::vector<double> sorted;
+    for (UpdateTiming const &timing : timings) { sorted.push_back(timing.ms); }
+    std::sort(sorted.begin(), sorted.end());
+
+    printf("updates: %zu  steps: %d  total: %.3f ms  checksum: %016llx\n", timings.size(), totalSteps, total, handler.getChecksum());
+    printf("per update (ms)  mean: %.4f  p50: %.4f  p99: %.4f  max: %.4f\n", total/timings.size(),
+           sorted[sorted.size()/2], sorted[(sorted.size() - 1)*99/100], sorted.back());
+
+    std::sort(timings.begin(), timings.end(), [](UpdateTiming const &a, UpdateTiming const &b) { return a.ms > b.ms; });
+    top = std::min(top, (int) timings.size());
+
+    printf("\nslowest updates:\n");
+    printf("  %8s %10s %6s %8s %8s %10s\n", "update", "ms", "steps", "rigid", "static", "kinematic");
+
+    for (int i = 0; i < top; ++i) {
+        UpdateTiming const &t = timings[i];
+        printf("  %8d %10.4f %6d %8d %8d %10d\n", t.index, t.ms, t.steps, t.rigidBodies, t.staticBodies, t.kinematicBodies);
+    }
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+// * ===================================
+// * Zero Allocation Stepping
+// * ===================================
+
+// Fill a handler with every rigid collider against every static and kinematic collider, sensors of each kind, bullets, and LOD tiers.
+static void buildAllocationWorld(Zeta::Handler &handler, int rigidBodies) {
+    Zeta::AABB floor1({-100, -6}, {0, -4});
+    Zeta::Box2D floor2({0, -6}, {100, -4}, 5.0f);
+    Zeta::Circle floor3({0, -30}, 25.0f);
+
+    handler.createStaticBody({-50, -5}, Zeta::STATIC_AABB_COLLIDER, &floor1);
+    handler.createStaticBody({50, -5}, Zeta::STATIC_BOX2D_COLLIDER, &floor2);
+    handler.createStaticBody({0, -30}, Zeta::STATIC_CIRCLE_COLLIDER, &floor3);
+
+    Zeta::AABB zone({-20, -4}, {20, 10});
+    handler.createStaticBody({0, 3}, Zeta::STATIC_AABB_COLLIDER, &zone)->sensor = 1;
+
+    for (int t = 0; t < 3; ++t) {
+        ZMath::Vec2D pos(-60.0f + 40*t, 2);
+
+        Zeta::Circle circle(pos, 3);
+        Zeta::AABB aabb(pos - ZMath::Vec2D(3, 3), pos + ZMath::Vec2D(3, 3));
+        Zeta::Box2D box(pos - ZMath::Vec2D(3, 3), pos + ZMath::Vec2D(3, 3), 20);
+        void* collider = t == 0 ? (void*) &circle : t == 1 ? (void*) &aabb : (void*) &box;
+
+        Zeta::KinematicBody2D* kb = handler.createKinematicBody(pos, (Zeta::KinematicBodyCollider) t, collider);
+        kb->sensor = t == 2;
+    }
+
+    for (int i = 0; i < rigidBodies; ++i) {
+        ZMath::Vec2D pos(-90.0f + (i % 60) * 3.0f, 5.0f + (i / 60) * 2.5f);
+        int t = i % 3;
+
+        Zeta::Circle circle(pos, 1);
+        Zeta::AABB aabb(pos - ZMath::Vec2D(1, 1), pos + ZMath::Vec2D(1, 1));
+        Zeta::Box2D box(pos - ZMath::Vec2D(1, 1), pos + ZMath::Vec2D(1, 1), 30);
+        void* collider = t == 0 ? (void*) &circle : t == 1 ? (void*) &aabb : (void*) &box;
+
+        Zeta::RigidBody2D* rb = handler.createRigidBody(pos, 1, 0.3f, 0.99f, (Zeta::RigidBodyCollider) t, collider);
+        rb->lodTier = i % 4;
+        rb->sensor = i % 50 == 0;
+        rb->bullet = i % 77 == 0;
+    }
+
+    Zeta::AABB region({-30, -10}, {30, 100});
+    handler.setActiveRegions(&region, 1);
+
+    handler.speculativeContacts = 1;
+    handler.enableContactEvents(1024);
+    handler.addObserver(Zeta::AABB({-40, -10}, {40, 40}));
+    handler.addObserver(Zeta::AABB({0, 0}, {100, 100}));
+};
+
+// Step a world for a number of frames and return how many allocations were made while stepping.
+// overflows is set to the number of contacts, overlaps, and events that were dropped.
+static long long stepAllocations(Zeta::Handler &handler, int frames, int &overflows) {
+    float dt = 0.0f;
+    Zeta::ContactEvent event;
+
+    overflows = 0;
+    allocationCount = 0;
+    countAllocations = 1;
+
+    for (int i = 0; i < frames; ++i) {
+        dt += 1.0f/60.0f;
+        handler.update(dt);
+
+        overflows += handler.getMemoryOverflows();
+        while (handler.getContactEvents()->pop(event)) {}
+    }
+
+    countAllocations = 0;
+    return allocationCount;
+};
+
+// Counts what passes through it on the way to the default new and delete resource.
+class CountingResource : public std::pmr::memory_resource {
+    public:
+        long long allocations = 0;
+        long long outstanding = 0; // bytes allocated and not yet freed
+
+    private:
+        void* do_allocate(size_t bytes, size_t align) override {
+            ++allocations;
+            outstanding += bytes;
+
+            // ? Counting pauses here so whatever the default resource calls is not taken for a fallback.
+            bool counting = countAllocations;
+            countAllocations = 0;
+            void* p = std::pmr::new_delete_resource()->allocate(bytes, align);
+            countAllocations = counting;
+
+            return p;
+        };
+
+        void do_deallocate(void* p, size_t bytes, size_t align) override {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        };
+
+        bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override { return this == &other; };
+};
+
+bool allocationTests() {
+    // ? UNIT_TEST evaluates its arguments more than once, so every world is stepped before it is checked.
+
+    bool failed = 0;
+    int overflows;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f));
+        buildAllocationWorld(handler, 300);
+        handler.reserve(303, 1024);
+
+        long long allocations = stepAllocations(handler, 300, overflows);
+        failed |= UNIT_TEST("Reserved Stepping Allocations", allocations, 0);
+        failed |= UNIT_TEST("Reserved Stepping Overflows", overflows, 0);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f));
+        buildAllocationWorld(handler, 300);
+        handler.reserve(303, 1024);
+        handler.memoryLimitMode = Zeta::DROP_OVERFLOW;
+
+        long long allocations = stepAllocations(handler, 300, overflows);
+        failed |= UNIT_TEST("Fixed Memory Stepping Allocations", allocations, 0);
+        failed |= UNIT_TEST("Fixed Memory Stepping Overflows", overflows, 0);
+    }
+
+    {
+        // too little memory for the contacts has to degrade instead of allocating
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f));
+        buildAllocationWorld(handler, 300);
+        handler.reserve(303, 16);
+        handler.memoryLimitMode = Zeta::DROP_OVERFLOW;
+
+        long long allocations = stepAllocations(handler, 300, overflows);
+        failed |= UNIT_TEST("Overflowing Stepping Allocations", allocations, 0);
+        failed |= UNIT_TEST("Overflowing Stepping Drops Contacts", overflows > 0, 1);
+    }
+
+    {
+        // warming up without reserving reaches a steady state too
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f));
+        buildAllocationWorld(handler, 300);
+        stepAllocations(handler, 120, overflows);
+
+        long long allocations = stepAllocations(handler, 300, overflows);
+        failed |= UNIT_TEST("Warmed Up Stepping Allocations", allocations, 0);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f));
+        buildAllocationWorld(handler, 300);
+        handler.reserve(303, 16);
+        handler.memoryLimitMode = Zeta::THROW_ON_OVERFLOW;
+
+        bool threw = 0;
+        try { stepAllocations(handler, 300, overflows); }
+        catch (std::runtime_error const &error) { threw = 1; }
+
+        countAllocations = 0;
+        failed |= UNIT_TEST("Overflow Throws", threw, 1);
+    }
+
+    {
+        // everything from building to destroying a handler goes through its memory resource
+        CountingResource resource;
+
+        allocationCount = 0;
+        countAllocations = 1;
+        long long passedOn = 0;
+
+        {
+            Zeta::Handler handler(ZMath::Vec2D(0, -9.8f), FPS_60, &resource);
+            buildAllocationWorld(handler, 300);
+
+            float dt = 0.0f;
+            Zeta::ContactEvent event;
+
+            for (int i = 0; i < 120; ++i) {
+                dt += 1.0f/60.0f;
+                handler.update(dt);
+                while (handler.getContactEvents()->pop(event)) {}
+            }
+
+            passedOn = resource.allocations;
+        }
+
+        countAllocations = 0;
+        long long global = allocationCount;
+
+        failed |= UNIT_TEST("Memory Resource Receives Allocations", passedOn > 0, 1);
+        failed |= UNIT_TEST("Nothing Falls Back To Global New", global, 0);
+        failed |= UNIT_TEST("Memory Resource Gets Everything Back", resource.outstanding, 0);
+    }
+
+    return failed;
+};
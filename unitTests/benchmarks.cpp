@@ -0,0 +1,380 @@
+#include <ZETA/physicshandler.h>
+#include <ZETA/replication.h>
+#include <ZETA/scene.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+// ? Benchmarks are built separately from the unit tests with optimizations on (make bench-linux).
+// ? Each one prints its own numbers. They are meant to be compared between two builds on the same machine.
+// ? Pass the name of a group of benchmarks (e.g. ./benchmarks Raycast) to only run that group.
+
+char const* benchmarkFilter = nullptr; // name of the only group of benchmarks to run. nullptr = all of them.
+
+// Time a function in seconds.
+template <typename Func>
+double timeSeconds(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+};
+
+// Counts the cache misses of the calling thread with perf_event_open where the kernel allows it.
+// Elsewhere (or without permission) every count is -1 and only the times are meaningful.
+struct CacheMissCounter {
+    int fd = -1;
+
+    inline CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(perf_event_attr));
+
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(perf_event_attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fd = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    };
+
+    inline ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) { close(fd); }
+#endif
+    };
+
+    // Count the cache misses of a function. Returns -1 if they cannot be counted.
+    template <typename Func>
+    long long count(Func func) {
+        if (fd < 0) {
+            func();
+            return -1;
+        }
+
+        long long misses = -1;
+
+#ifdef __linux__
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        func();
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (read(fd, &misses, sizeof(long long)) != sizeof(long long)) { misses = -1; }
+#endif
+
+        return misses;
+    };
+};
+
+// Run a function of benchmarks.
+void benchmark(std::string const &name, void (*func)()) {
+    if (benchmarkFilter && name != benchmarkFilter) { return; }
+
+    std::cout << "================== " << name << " Benchmarks. ==================\n\n";
+    func();
+    std::cout << "\n";
+};
+
+
+// * ===================================
+// * Replication
+// * ===================================
+
+// Encode a large drifting world for several clients every tick and decode it for one of them.
+void replicationBenchmarks() {
+    const int BODIES = 10000, CLIENTS = 8, TICKS = 120;
+
+    Zeta::Handler handler(ZMath::Vec2D(0, 0));
+
+    for (int i = 0; i < BODIES; ++i) {
+        ZMath::Vec2D pos(3.0f*(i % 100), 3.0f*(i / 100));
+        Zeta::Circle circle(pos, 1);
+
+        Zeta::RigidBody2D* rb = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        rb->sensor = 1;
+
+        // a quarter of the bodies are at rest
+        if (i % 4) { rb->vel.set(0.01f*(i % 37) - 0.18f, 0.01f*(i % 23) - 0.11f); }
+    }
+
+    Zeta::ReplicationEncoder encoder;
+    Zeta::ReplicationDecoder decoder;
+    int clients[CLIENTS];
+    for (int c = 0; c < CLIENTS; ++c) { clients[c] = encoder.addClient(); }
+
+    size_t capacity = 32*BODIES;
+    uint8_t* buffer = new uint8_t[capacity];
+
+    double encodeTime = 0, decodeTime = 0;
+    size_t bytes = 0;
+
+    for (int tick = 0; tick < TICKS; ++tick) {
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        size_t size = 0;
+
+        encodeTime += timeSeconds([&]() {
+            encoder.capture(handler);
+            for (int c = 0; c < CLIENTS; ++c) { size = encoder.encode(clients[c], buffer, capacity); }
+        });
+
+        decodeTime += timeSeconds([&]() { decoder.decode(buffer, size); });
+        bytes += size;
+    }
+
+    delete[] buffer;
+
+    double encoded = (double) BODIES*CLIENTS*TICKS, decoded = (double) BODIES*TICKS;
+
+    std::cout << "Bodies: " << BODIES << ". Clients: " << CLIENTS << ". Ticks: " << TICKS << ".\n";
+    std::cout << "Encode: " << encoded/encodeTime/1e6 << " M bodies/s (" << 1e3*encodeTime/TICKS << " ms per tick).\n";
+    std::cout << "Decode: " << decoded/decodeTime/1e6 << " M bodies/s (" << 1e3*decodeTime/TICKS << " ms per tick).\n";
+    std::cout << "Packet: " << (double) bytes/TICKS << " bytes per client per tick (" << 8.0*bytes/decoded << " bits per body).\n";
+};
+
+
+// * ===================================
+// * Scene Loading
+// * ===================================
+
+// Compare starting a level by adding its static bodies and building the tree against loading the same level from a scene file.
+void sceneBenchmarks() {
+    const int BODIES = 100000;
+    const char* path = "benchmarkScene.zscn";
+
+    // a rigid body to step, so the first update builds everything it needs
+    ZMath::Vec2D pos(-10, -10);
+    Zeta::Circle circle(pos, 0.5f);
+
+    double buildTime, loadTime;
+
+    // the handlers are gone before the file is removed, since a mapped file cannot be removed on every platform
+    {
+        Zeta::Handler built(ZMath::Vec2D(0, 0));
+
+        buildTime = timeSeconds([&]() {
+            for (int i = 0; i < BODIES; ++i) {
+                ZMath::Vec2D p(4.0f*(i % 300), 4.0f*(i / 300));
+                Zeta::AABB aabb(p - 1, p + 1);
+                built.addStaticBody(new Zeta::StaticBody2D(p, Zeta::STATIC_AABB_COLLIDER, &aabb));
+            }
+
+            built.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+            float dt = 1.0f/60.0f + 0.0001f;
+            built.update(dt);
+        });
+
+        built.saveScene(path);
+        Zeta::Handler loaded(ZMath::Vec2D(0, 0));
+
+        loadTime = timeSeconds([&]() {
+            loaded.loadScene(path);
+            loaded.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+            float dt = 1.0f/60.0f + 0.0001f;
+            loaded.update(dt);
+        });
+    }
+
+    remove(path);
+
+    std::cout << "Static bodies: " << BODIES << ".\n";
+    std::cout << "Add bodies and first step: " << 1e3*buildTime << " ms.\n";
+    std::cout << "Load scene and first step: " << 1e3*loadTime << " ms (" << buildTime/loadTime << "x faster).\n";
+};
+
+
+// * ===================================
+// * Raycasts
+// * ===================================
+
+// Cast fans of rays through a field of mixed bodies one at a time and as packets.
+void raycastBenchmarks() {
+    const int BODIES = 4000, RAYS = 64000, FAN = 64;
+    const float MAX_DIST = 300.0f;
+
+    Zeta::Handler handler(ZMath::Vec2D(0, 0));
+    srand(1);
+
+    for (int i = 0; i < BODIES; ++i) {
+        ZMath::Vec2D pos(rand() % 2000, rand() % 2000);
+
+        if (i % 3 == 0) {
+            Zeta::Circle circle(pos, 2);
+            handler.createStaticBody(pos, Zeta::STATIC_CIRCLE_COLLIDER, &circle);
+
+        } else if (i % 3 == 1) {
+            Zeta::AABB aabb(pos, pos + ZMath::Vec2D(3, 4));
+            handler.createRigidBody(aabb.pos, 1, 0.5f, 1.0f, Zeta::RIGID_AABB_COLLIDER, &aabb);
+
+        } else {
+            Zeta::Box2D box(pos, pos + ZMath::Vec2D(3, 4), 30);
+            handler.createStaticBody(box.pos, Zeta::STATIC_BOX2D_COLLIDER, &box);
+        }
+    }
+
+    // line of sight checks: fans of rays from random origins
+    Zeta::Ray2D* rays = (Zeta::Ray2D*) malloc(RAYS*sizeof(Zeta::Ray2D));
+
+    for (int f = 0; f < RAYS/FAN; ++f) {
+        ZMath::Vec2D origin(rand() % 2000, rand() % 2000);
+
+        for (int i = 0; i < FAN; ++i) {
+            float angle = 6.2831853f*i/FAN;
+            new (&rays[f*FAN + i]) Zeta::Ray2D(origin, ZMath::Vec2D(cosf(angle), sinf(angle)));
+        }
+    }
+
+    Zeta::RaycastHit* hits = new Zeta::RaycastHit[RAYS];
+
+    // builds the trees
+    handler.raycast(rays, FAN, hits, MAX_DIST);
+
+    int scalarHits = 0, packetHits = 0;
+
+    double scalarTime = timeSeconds([&]() {
+        for (int i = 0; i < RAYS; ++i) { scalarHits += handler.raycast(rays[i], hits[i], MAX_DIST); }
+    });
+
+    double packetTime = timeSeconds([&]() { packetHits = handler.raycast(rays, RAYS, hits, MAX_DIST); });
+
+    free(rays);
+    delete[] hits;
+
+    std::cout << "Bodies: " << BODIES << ". Rays: " << RAYS << " in fans of " << FAN << ". Hits: " << scalarHits << " scalar, " << packetHits << " packet.\n";
+    std::cout << "Scalar raycast: " << RAYS/scalarTime/1e6 << " M rays/s.\n";
+    std::cout << "Packet raycast: " << RAYS/packetTime/1e6 << " M rays/s (" << scalarTime/packetTime << "x).\n";
+};
+
+
+// * ===================================
+// * Body Layout
+// * ===================================
+
+// Print the time and cache misses per body of a pass over every body.
+template <typename Func>
+void timeBodyPass(CacheMissCounter &counter, char const* name, int bodies, Func func) {
+    double time = 0;
+    long long misses = counter.count([&]() { time = timeSeconds(func); });
+
+    std::cout << name << ": " << 1e9*time/bodies << " ns per body";
+    if (misses >= 0) { std::cout << ", " << (double) misses/bodies << " cache misses per body"; }
+    std::cout << ".\n";
+};
+
+// Fill a handler with rigid circles in a grid far enough apart that none of them collide.
+static void buildLayoutWorld(Zeta::Handler &handler, int bodies) {
+    int pool = handler.createRigidBodyPool(bodies);
+
+    for (int i = 0; i < bodies; ++i) {
+        ZMath::Vec2D pos(4.0f*(i % 1000), 4.0f*(i / 1000));
+        Zeta::Circle circle(pos, 1);
+        Zeta::RigidBody2D body(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        body.vel.set(0.1f, -0.1f);
+
+        handler.spawnRigidBody(pool, body);
+    }
+};
+
+// Run the passes that read the hot fields of every rigid body over far more bodies than fit in cache.
+void layoutBenchmarks() {
+    const int BODIES = 500000, STEP_BODIES = 10000;
+
+    std::cout << "sizeof(RigidBody2D): " << sizeof(Zeta::RigidBody2D) << " bytes.\n";
+
+    CacheMissCounter counter;
+    if (counter.fd < 0) { std::cout << "Cache miss counters are not available, so only times are shown.\n"; }
+
+    // evict the bodies between passes
+    size_t evictSize = 64 << 20;
+    char* evict = new char[evictSize];
+    auto flush = [&]() { memset(evict, 1, evictSize); };
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildLayoutWorld(handler, BODIES);
+
+        std::cout << "Passes over " << BODIES << " bodies:\n";
+
+        flush();
+        timeBodyPass(counter, "Integrate", BODIES, [&]() {
+            for (int i = 0; i < BODIES; ++i) { handler.getRigidBody(i)->update(ZMath::Vec2D(0, 0), 1.0f/60.0f); }
+        });
+
+        // what refitting the tree and culling by bounds read
+        int inside = 0;
+
+        flush();
+        timeBodyPass(counter, "Bounds sweep", BODIES, [&]() {
+            for (int i = 0; i < BODIES; ++i) {
+                Zeta::RigidBody2D const* rb = handler.getRigidBody(i);
+                inside += rb->boundsMin.x < 2000.0f && rb->boundsMax.y > 1000.0f && rb->pos.x > 10.0f;
+            }
+        });
+
+        // bodies visited out of order, like bodies allocated on their own or reached through the tree
+        int* order = new int[BODIES];
+        for (int i = 0; i < BODIES; ++i) { order[i] = i; }
+        for (int i = BODIES - 1; i > 0; --i) { std::swap(order[i], order[rand() % (i + 1)]); }
+
+        flush();
+        timeBodyPass(counter, "Bounds sweep in random order", BODIES, [&]() {
+            for (int i = 0; i < BODIES; ++i) {
+                Zeta::RigidBody2D const* rb = handler.getRigidBody(order[i]);
+                inside += rb->boundsMin.x < 2000.0f && rb->boundsMax.y > 1000.0f && rb->pos.x > 10.0f;
+            }
+        });
+
+        delete[] order;
+
+        std::cout << "(" << inside << " bodies inside the swept regions.)\n";
+    }
+
+    {
+        // rigid body pairs are culled by bounds before any collider is read
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildLayoutWorld(handler, STEP_BODIES);
+
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        std::cout << "Steps of " << STEP_BODIES << " bodies:\n";
+
+        flush();
+        timeBodyPass(counter, "Handler step", STEP_BODIES, [&]() {
+            float dt = 1.0f/60.0f + 0.0001f;
+            handler.update(dt);
+        });
+    }
+
+    delete[] evict;
+};
+
+int main(int argc, char** argv) {
+    if (argc > 1) { benchmarkFilter = argv[1]; }
+
+    benchmark("Replication", replicationBenchmarks);
+    benchmark("Scene", sceneBenchmarks);
+    benchmark("Raycast", raycastBenchmarks);
+    benchmark("Body Layout", layoutBenchmarks);
+
+    return 0;
+};
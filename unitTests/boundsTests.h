@@ -0,0 +1,67 @@
+#pragma once
+
+// * ===================================
+// * Cached Bounds
+// * ===================================
+
+// Call update once and count the contacts that began during it.
+static int stepContactBegins(Zeta::Handler &handler) {
+    float dt = 1.0f/60.0f + 0.0001f;
+    handler.update(dt);
+
+    int begins = 0;
+    Zeta::ContactEvent contact;
+    while (handler.getContactEvents()->pop(contact)) { begins += contact.type == Zeta::CONTACT_BEGIN; }
+
+    return begins;
+};
+
+bool boundsTests() {
+    bool failed = 0;
+
+    {
+        // the pair is only tested against the cached bounds, so overlapping colliders with disjoint bounds never collide
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        handler.enableContactEvents(16);
+
+        Zeta::Circle c1(ZMath::Vec2D(0, 0), 0.5f);
+        Zeta::Circle c2(ZMath::Vec2D(0.6f, 0), 0.5f);
+        Zeta::RigidBody2D* rb1 = handler.createRigidBody(c1.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &c1);
+        Zeta::RigidBody2D* rb2 = handler.createRigidBody(c2.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &c2);
+
+        rb2->boundsMin.set(100, 100);
+        rb2->boundsMax.set(101, 101);
+
+        int stale = stepContactBegins(handler);
+        failed |= UNIT_TEST("Disjoint Bounds Skip The Narrowphase", stale == 0 && rb1->pos == c1.c && rb2->pos == c2.c, 1);
+
+        // stepping the bodies found their bounds again
+        int fresh = stepContactBegins(handler);
+        failed |= UNIT_TEST("Refreshed Bounds Reach The Narrowphase", fresh, 1);
+    }
+
+    {
+        // kinematic bodies are moved by the game, so their bounds are found again at the start of every update
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        handler.enableContactEvents(16);
+
+        Zeta::Circle circle(ZMath::Vec2D(0, 0), 0.5f);
+        handler.createRigidBody(circle.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        Zeta::AABB aabb(ZMath::Vec2D(9.5f, -0.5f), ZMath::Vec2D(10.5f, 0.5f));
+        Zeta::KinematicBody2D* kb = handler.createKinematicBody(aabb.pos, Zeta::KINEMATIC_AABB_COLLIDER, &aabb);
+
+        int apart = stepContactBegins(handler);
+
+        kb->pos.set(0.8f, 0);
+        kb->collider.aabb.pos = kb->pos;
+
+        int moved = stepContactBegins(handler);
+        bool current = kb->boundsMin == kb->collider.aabb.getMin() && kb->boundsMax == kb->collider.aabb.getMax();
+
+        failed |= UNIT_TEST("Kinematic Bounds Follow A Move", current, 1);
+        failed |= UNIT_TEST("Moved Kinematic Body Collides", apart == 0 && moved == 1, 1);
+    }
+
+    return failed;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+// * ===================================
+// * Continuous Collisions
+// * ===================================
+
+bool continuousTests() {
+    bool failed = 0;
+
+    {
+        // a small bullet crossing 50 units a step meets a thin wall running diagonally through the origin
+        int tunneled = 0;
+
+        for (int i = 0; i < 16; ++i) {
+            Zeta::Handler handler(ZMath::Vec2D(0, 0), FPS_60);
+
+            Zeta::Box2D wall(ZMath::Vec2D(-50, -0.01f), ZMath::Vec2D(50, 0.01f), 45);
+            handler.createStaticBody(wall.pos, Zeta::STATIC_BOX2D_COLLIDER, &wall);
+
+            ZMath::Vec2D pos(-30.0f + 0.37f*i, 0.61f*i - 4.0f);
+            Zeta::Circle circle(pos, 0.05f);
+
+            Zeta::RigidBody2D* rb = handler.createRigidBody(pos, 1, 1.0f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+            rb->vel.set(3000, 0);
+            rb->bullet = 1;
+
+            for (int j = 0; j < 3; ++j) {
+                float dt = FPS_60;
+                handler.update(dt);
+            }
+
+            // the wall is the line y = x, so the bullet has to stay on the left of it
+            tunneled += rb->pos.x > rb->pos.y;
+        }
+
+        failed |= UNIT_TEST("Bullet Does Not Tunnel Through A Thin Wall", tunneled, 0);
+    }
+
+    {
+        // a circle crossing 2 units a step, or 8 in LOD tier 2, would skip over a thin wall without a speculative contact
+        float lastX[2];
+
+        for (int tier = 0; tier < 2; ++tier) {
+            Zeta::Handler handler(ZMath::Vec2D(0, 0), FPS_60);
+            handler.speculativeContacts = 1;
+
+            Zeta::AABB wall(ZMath::Vec2D(5, -10), ZMath::Vec2D(5.05f, 10));
+            handler.createStaticBody(wall.pos, Zeta::STATIC_AABB_COLLIDER, &wall);
+
+            Zeta::Circle circle(ZMath::Vec2D(0, 0), 0.25f);
+            Zeta::RigidBody2D* rb = handler.createRigidBody(circle.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+            rb->vel.set(120, 0);
+            rb->lodTier = 2*tier;
+
+            lastX[tier] = rb->pos.x;
+
+            for (int j = 0; j < 16; ++j) {
+                float dt = FPS_60;
+                handler.update(dt);
+                lastX[tier] = MAX(lastX[tier], rb->pos.x);
+            }
+        }
+
+        failed |= UNIT_TEST("Speculative Contact Stops A Fast Body", lastX[0] <= 4.76f, 1);
+        failed |= UNIT_TEST("Speculative Contact Uses The LOD Step", lastX[1] <= 4.76f, 1);
+    }
+
+    return failed;
+};
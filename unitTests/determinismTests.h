@@ -0,0 +1,39 @@
+#pragma once
+
+// * ===================================
+// * Determinism
+// * ===================================
+
+// Build the allocation test world, then step it with reorders and return its checksum.
+static unsigned long long runDeterminismWorld(int frames) {
+    Zeta::Handler handler(ZMath::Vec2D(0, -9.8f));
+    buildAllocationWorld(handler, 300);
+    handler.reorderInterval = 7;
+
+    float dt = 0.0f;
+    Zeta::ContactEvent event;
+
+    for (int i = 0; i < frames; ++i) {
+        dt += 1.0f/60.0f;
+        handler.update(dt);
+
+        while (handler.getContactEvents()->pop(event)) {}
+    }
+
+    return handler.getChecksum();
+};
+
+bool determinismTests() {
+    bool failed = 0;
+
+    {
+        // ? The second run's bodies live at different addresses, so anything ordered by pointer would show up here.
+        // ? Build with make linux-deterministic to run this with ZETA_DETERMINISTIC as well.
+        unsigned long long first = runDeterminismWorld(200);
+        unsigned long long second = runDeterminismWorld(200);
+
+        failed |= UNIT_TEST("Same Scene Twice Matches", first == second, 1);
+    }
+
+    return failed;
+};
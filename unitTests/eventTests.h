@@ -0,0 +1,238 @@
+#pragma once
+
+// * ===================================
+// * Contact and Sensor Events
+// * ===================================
+
+// Count the events of each type generated by a number of calls to update.
+struct EventCounts {
+    int contacts[3] = {0, 0, 0}; // indexed by ContactEventType
+    int sensors[3] = {0, 0, 0}; // indexed by SensorEventType
+};
+
+static EventCounts stepEvents(Zeta::Handler &handler, int frames, float &dt) {
+    EventCounts counts;
+    Zeta::ContactEvent contact;
+
+    for (int i = 0; i < frames; ++i) {
+        dt += 1.0f/60.0f;
+        handler.update(dt);
+
+        while (handler.getContactEvents()->pop(contact)) { ++counts.contacts[contact.type]; }
+
+        int count;
+        Zeta::SensorEvent const* events = handler.getSensorEvents(count);
+        for (int j = 0; j < count; ++j) { ++counts.sensors[events[j].type]; }
+    }
+
+    return counts;
+};
+
+// Build a row of resting circles on the ground and a few overlapping sensors without gravity, so every contact persists.
+// The bodies are added from right to left, the opposite of the order a reorder sorts them into.
+static void buildRestingWorld(Zeta::Handler &handler) {
+    Zeta::AABB ground({-10, -2}, {30, -0.9f});
+    handler.createStaticBody({10, -1.45f}, Zeta::STATIC_AABB_COLLIDER, &ground);
+
+    for (int i = 9; i >= 0; --i) {
+        ZMath::Vec2D pos(1.8f*i, 0);
+        Zeta::Circle circle(pos, 1);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+    }
+
+    for (int i = 2; i >= 0; --i) {
+        ZMath::Vec2D pos(1.5f*i, 20);
+        Zeta::Circle circle(pos, 1);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle)->sensor = i < 2;
+    }
+
+    handler.enableContactEvents(256);
+};
+
+// Count the sensor events of a type generated by the last call to update.
+static int countSensorEvents(Zeta::Handler const &handler, Zeta::SensorEventType type) {
+    int count, found = 0;
+    Zeta::SensorEvent const* events = handler.getSensorEvents(count);
+
+    for (int i = 0; i < count; ++i) { found += events[i].type == type; }
+    return found;
+};
+
+// Build a static sensor at the origin overlapping a circle and a circle sensor, which also overlap each other, without gravity.
+static void buildSensorWorld(Zeta::Handler &handler) {
+    Zeta::AABB box({-0.5f, -0.5f}, {0.5f, 0.5f});
+    handler.createStaticBody({0, 0}, Zeta::STATIC_AABB_COLLIDER, &box)->sensor = 1;
+
+    Zeta::Circle circle({0, 0}, 0.25f);
+    handler.createRigidBody(circle.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+    Zeta::Circle sensor({0.3f, 0}, 0.25f);
+    handler.createRigidBody(sensor.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &sensor)->sensor = 1;
+
+    handler.enableContactEvents(256);
+};
+
+bool eventTests() {
+    bool failed = 0;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildRestingWorld(handler);
+
+        float dt = 0.0f;
+        stepEvents(handler, 3, dt);
+        EventCounts counts = stepEvents(handler, 30, dt);
+
+        failed |= UNIT_TEST("Resting Contacts Persist", counts.contacts[Zeta::CONTACT_PERSIST] > 0, 1);
+        failed |= UNIT_TEST("Resting Contacts Do Not Begin", counts.contacts[Zeta::CONTACT_BEGIN], 0);
+        failed |= UNIT_TEST("Resting Contacts Do Not End", counts.contacts[Zeta::CONTACT_END], 0);
+        failed |= UNIT_TEST("Resting Overlaps Stay", counts.sensors[Zeta::SENSOR_STAY] > 0, 1);
+    }
+
+    {
+        // reordering flips which body of most pairs comes first
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildRestingWorld(handler);
+
+        float dt = 0.0f;
+        EventCounts first = stepEvents(handler, 3, dt);
+
+        handler.reorderInterval = 1;
+        EventCounts counts = stepEvents(handler, 30, dt);
+
+        failed |= UNIT_TEST("Reorder Sorts The Row", handler.getRigidBody(0)->pos.x < handler.getRigidBody(1)->pos.x, 1);
+        failed |= UNIT_TEST("Reorder Contacts Begin Once", first.contacts[Zeta::CONTACT_BEGIN] > 0, 1);
+        failed |= UNIT_TEST("Reorder Contacts Persist", counts.contacts[Zeta::CONTACT_PERSIST] > 0, 1);
+        failed |= UNIT_TEST("Reorder Contacts Do Not Begin", counts.contacts[Zeta::CONTACT_BEGIN], 0);
+        failed |= UNIT_TEST("Reorder Contacts Do Not End", counts.contacts[Zeta::CONTACT_END], 0);
+        failed |= UNIT_TEST("Reorder Overlaps Stay", counts.sensors[Zeta::SENSOR_STAY] > 0, 1);
+        failed |= UNIT_TEST("Reorder Overlaps Do Not Enter", counts.sensors[Zeta::SENSOR_ENTER], 0);
+        failed |= UNIT_TEST("Reorder Overlaps Do Not Exit", counts.sensors[Zeta::SENSOR_EXIT], 0);
+    }
+
+    {
+        // despawning the first body moves the last body, a sensor, into its index
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildRestingWorld(handler);
+
+        float dt = 0.0f;
+        stepEvents(handler, 3, dt);
+
+        handler.despawnRigidBody(handler.getRigidBody(0));
+        EventCounts counts = stepEvents(handler, 30, dt);
+
+        failed |= UNIT_TEST("Despawn Contacts Persist", counts.contacts[Zeta::CONTACT_PERSIST] > 0, 1);
+        failed |= UNIT_TEST("Despawn Contacts Do Not Begin", counts.contacts[Zeta::CONTACT_BEGIN], 0);
+        failed |= UNIT_TEST("Despawn Overlaps Stay", counts.sensors[Zeta::SENSOR_STAY] > 0, 1);
+        failed |= UNIT_TEST("Despawn Overlaps Do Not Enter", counts.sensors[Zeta::SENSOR_ENTER], 0);
+        failed |= UNIT_TEST("Despawn Overlaps Do Not Exit", counts.sensors[Zeta::SENSOR_EXIT], 0);
+    }
+
+    {
+        // bodies in LOD tier 2 are only collided every 4th step
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildRestingWorld(handler);
+        for (int i = 0; i < handler.getRigidBodyCount(); ++i) { handler.getRigidBody(i)->lodTier = 2; }
+
+        float dt = 0.0f;
+        stepEvents(handler, 6, dt);
+        EventCounts counts = stepEvents(handler, 30, dt);
+
+        failed |= UNIT_TEST("LOD Contacts Persist", counts.contacts[Zeta::CONTACT_PERSIST] > 0, 1);
+        failed |= UNIT_TEST("LOD Contacts Do Not Begin", counts.contacts[Zeta::CONTACT_BEGIN], 0);
+        failed |= UNIT_TEST("LOD Contacts Do Not End", counts.contacts[Zeta::CONTACT_END], 0);
+    }
+
+    {
+        // a circle flies through a static sensor, so the overlap begins and ends part way through
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+
+        Zeta::AABB box({-0.5f, -0.5f}, {0.5f, 0.5f});
+        handler.createStaticBody({0, 0}, Zeta::STATIC_AABB_COLLIDER, &box)->sensor = 1;
+
+        Zeta::Circle circle({-3, 0}, 0.25f);
+        Zeta::RigidBody2D* rb = handler.createRigidBody(circle.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        rb->vel.set(3, 0);
+
+        // overlaps are found before the bodies move, so each step sees where the circle was when it began
+        int enterFrame = -1, exitFrame = -1, overlapFrame = -1, separateFrame = -1;
+        int enters = 0, exits = 0, eventFrames = 0;
+
+        for (int i = 0; i < 150; ++i) {
+            if (overlapFrame == -1 && rb->pos.x > -0.75f) { overlapFrame = i; }
+            if (separateFrame == -1 && rb->pos.x >= 0.75f) { separateFrame = i; }
+
+            float dt = 1.0f/60.0f + 0.0001f;
+            handler.update(dt);
+
+            int count;
+            handler.getSensorEvents(count);
+            eventFrames += count > 0;
+
+            int entered = countSensorEvents(handler, Zeta::SENSOR_ENTER);
+            int exited = countSensorEvents(handler, Zeta::SENSOR_EXIT);
+
+            if (entered && enterFrame == -1) { enterFrame = i; }
+            if (exited && exitFrame == -1) { exitFrame = i; }
+
+            enters += entered;
+            exits += exited;
+        }
+
+        // every frame from the enter to the exit has exactly one event, a stay in between
+        failed |= UNIT_TEST("Enter Fires Once", enters, 1);
+        failed |= UNIT_TEST("Enter Fires On The First Overlapping Step", enterFrame != -1 && enterFrame == overlapFrame, 1);
+        failed |= UNIT_TEST("Exit Fires Once", exits, 1);
+        failed |= UNIT_TEST("Exit Fires When The Overlap Ends", exitFrame != -1 && exitFrame == separateFrame, 1);
+        failed |= UNIT_TEST("Overlap Reports Every Step", eventFrames, exitFrame - enterFrame + 1);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildSensorWorld(handler);
+
+        Zeta::StaticBody2D* box = handler.getStaticBody(0);
+        Zeta::RigidBody2D* circle = handler.getRigidBody(0);
+        Zeta::RigidBody2D* sensor = handler.getRigidBody(1);
+
+        float dt = 0.0f;
+        stepEvents(handler, 3, dt);
+
+        // the circle overlaps both sensors, so removing it ends both overlaps
+        handler.removeRigidBody(circle);
+
+        dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        int count;
+        Zeta::SensorEvent const* events = handler.getSensorEvents(count);
+        int exits = 0;
+
+        for (int i = 0; i < count; ++i) {
+            if (events[i].type == Zeta::SENSOR_EXIT && events[i].other.body == circle) { ++exits; }
+        }
+
+        failed |= UNIT_TEST("Removing A Body Exits Its Overlaps", exits, 2);
+        int stays = countSensorEvents(handler, Zeta::SENSOR_STAY);
+        failed |= UNIT_TEST("Remaining Overlap Stays", stays, 1);
+
+        dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        int exited = countSensorEvents(handler, Zeta::SENSOR_EXIT);
+        failed |= UNIT_TEST("Removal Exits Fire Once", exited, 0);
+
+        // removing a sensor ends its overlaps the same way
+        handler.removeRigidBody(sensor);
+
+        dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        events = handler.getSensorEvents(count);
+        bool exitedSensor = count == 1 && events[0].type == Zeta::SENSOR_EXIT && events[0].sensor.body == sensor && events[0].other.body == box;
+
+        failed |= UNIT_TEST("Removing A Sensor Exits Its Overlaps", exitedSensor, 1);
+    }
+
+    return failed;
+};
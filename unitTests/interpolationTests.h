@@ -0,0 +1,99 @@
+#pragma once
+
+// * ===================================
+// * Render Interpolation
+// * ===================================
+
+// Build two far apart circles moving to the right without gravity and step until the leftover dt sits between two steps.
+static void buildInterpolationWorld(Zeta::Handler &handler, Zeta::RigidBody2D** bodies) {
+    for (int i = 0; i < 2; ++i) {
+        ZMath::Vec2D pos(10.0f*i, 0);
+        Zeta::Circle circle(pos, 1);
+
+        bodies[i] = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        bodies[i]->vel.set(60, 0);
+    }
+
+    float dt = 1.5f/60.0f;
+    handler.update(dt);
+};
+
+// Count the positions that do not match the current position of the body stored at the same index.
+static int countStale(Zeta::Handler &handler) {
+    ZMath::Vec2D positions[4];
+    int count = handler.getInterpolatedPositions(positions, 4);
+    int stale = 0;
+
+    for (int i = 0; i < count; ++i) { stale += positions[i] != handler.getRigidBody(i)->pos; }
+
+    return stale;
+};
+
+bool interpolationTests() {
+    bool failed = 0;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[2];
+        buildInterpolationWorld(handler, bodies);
+
+        float alpha = handler.getInterpolationAlpha();
+        failed |= UNIT_TEST("Interpolation Between Steps", alpha > 0.0f && alpha < 1.0f, 1);
+
+        int stale = countStale(handler);
+        failed |= UNIT_TEST("Interpolated Positions Trail The Bodies", stale, 2);
+    }
+
+    {
+        // the count stays the same, but the body at index 0 is a different one
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[2];
+        buildInterpolationWorld(handler, bodies);
+
+        handler.removeRigidBody(bodies[0]);
+
+        ZMath::Vec2D pos(-50, 0);
+        Zeta::Circle circle(pos, 1);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        int stale = countStale(handler);
+        failed |= UNIT_TEST("Remove And Add Falls Back On Current Positions", stale, 0);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[2];
+        buildInterpolationWorld(handler, bodies);
+
+        // despawning moves the second body to index 0
+        handler.despawnRigidBody(bodies[0]);
+
+        ZMath::Vec2D pos(-50, 0);
+        Zeta::Circle circle(pos, 1);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        int stale = countStale(handler);
+        failed |= UNIT_TEST("Despawn And Add Falls Back On Current Positions", stale, 0);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[2];
+        buildInterpolationWorld(handler, bodies);
+
+        size_t size = handler.getSnapshotSize();
+        char* snapshot = new char[size];
+        handler.saveSnapshot(snapshot, size);
+
+        float dt = 3.0f/60.0f;
+        handler.update(dt);
+        bool restored = handler.restoreSnapshot(snapshot, size);
+        delete[] snapshot;
+
+        int stale = countStale(handler);
+        failed |= UNIT_TEST("Restore Succeeds", restored, 1);
+        failed |= UNIT_TEST("Restore Falls Back On Current Positions", stale, 0);
+    }
+
+    return failed;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+// * ===================================
+// * Level of Detail
+// * ===================================
+
+// Build a row of far apart circles in LOD tier 1 moving to the right without gravity.
+// The bodies are added from right to left, the opposite of the order a reorder sorts them into.
+static void buildLODWorld(Zeta::Handler &handler, Zeta::RigidBody2D** bodies, int count) {
+    for (int i = count - 1; i >= 0; --i) {
+        ZMath::Vec2D pos(10.0f*i, 0);
+        Zeta::Circle circle(pos, 1);
+
+        bodies[i] = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        bodies[i]->vel.set(1, 0);
+        bodies[i]->lodTier = 1;
+    }
+};
+
+// Track whether each body moved on the last step. Removed bodies are set to nullptr.
+struct LODTracker {
+    Zeta::RigidBody2D* bodies[8];
+    float last[8];
+    int moved[8];
+    int count;
+};
+
+static void trackLOD(LODTracker &tracker, Zeta::RigidBody2D** bodies, int count) {
+    tracker.count = count;
+
+    for (int i = 0; i < count; ++i) {
+        tracker.bodies[i] = bodies[i];
+        tracker.last[i] = bodies[i]->pos.x;
+        tracker.moved[i] = -1;
+    }
+};
+
+// Step the handler one step at a time and check each body is moved on exactly every other step.
+// Returns the number of times a body was stepped twice in a row or skipped twice in a row.
+static int stepLOD(Zeta::Handler &handler, LODTracker &tracker, int frames, float &dt) {
+    int misses = 0;
+
+    for (int f = 0; f < frames; ++f) {
+        dt += 1.0f/60.0f;
+        handler.update(dt);
+
+        for (int i = 0; i < tracker.count; ++i) {
+            if (!tracker.bodies[i]) { continue; }
+
+            int m = tracker.bodies[i]->pos.x != tracker.last[i];
+            if (tracker.moved[i] == m) { ++misses; }
+
+            tracker.last[i] = tracker.bodies[i]->pos.x;
+            tracker.moved[i] = m;
+        }
+    }
+
+    return misses;
+};
+
+bool lodTests() {
+    bool failed = 0;
+    const int count = 6; // even, so reversing the row moves every body to an index of the other parity
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[count];
+        buildLODWorld(handler, bodies, count);
+
+        LODTracker tracker;
+        trackLOD(tracker, bodies, count);
+
+        float dt = 0.0f;
+        stepLOD(handler, tracker, 3, dt);
+        int misses = stepLOD(handler, tracker, 20, dt);
+
+        failed |= UNIT_TEST("LOD Tier 1 Steps Every Other Step", misses, 0);
+    }
+
+    {
+        // a reorder every step reverses the row, moving every body to a new index
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[count];
+        buildLODWorld(handler, bodies, count);
+
+        LODTracker tracker;
+        trackLOD(tracker, bodies, count);
+
+        float dt = 0.0f;
+        stepLOD(handler, tracker, 3, dt);
+
+        handler.reorderInterval = 1;
+        int misses = stepLOD(handler, tracker, 20, dt);
+
+        failed |= UNIT_TEST("Reorder Sorts The Row", handler.getRigidBody(0)->pos.x < handler.getRigidBody(1)->pos.x, 1);
+        failed |= UNIT_TEST("Reorder Keeps LOD Phases", misses, 0);
+    }
+
+    {
+        // removing the first body shifts every other body down one index
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[count];
+        buildLODWorld(handler, bodies, count);
+
+        LODTracker tracker;
+        trackLOD(tracker, bodies, count);
+
+        float dt = 0.0f;
+        stepLOD(handler, tracker, 3, dt);
+
+        Zeta::RigidBody2D* first = handler.getRigidBody(0);
+        for (int i = 0; i < count; ++i) { if (tracker.bodies[i] == first) { tracker.bodies[i] = nullptr; } }
+        handler.removeRigidBody(first);
+
+        int misses = stepLOD(handler, tracker, 20, dt);
+
+        failed |= UNIT_TEST("Removal Keeps LOD Phases", misses, 0);
+    }
+
+    {
+        // despawning moves the last body into the despawned body's index
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        int pool = handler.createRigidBodyPool(count);
+
+        Zeta::RigidBody2D* bodies[count];
+        for (int i = count - 1; i >= 0; --i) {
+            ZMath::Vec2D pos(10.0f*i, 0);
+            Zeta::Circle circle(pos, 1);
+
+            Zeta::RigidBody2D body(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+            body.vel.set(1, 0);
+            body.lodTier = 1;
+
+            bodies[i] = handler.spawnRigidBody(pool, body);
+        }
+
+        LODTracker tracker;
+        trackLOD(tracker, bodies, count);
+
+        float dt = 0.0f;
+        stepLOD(handler, tracker, 3, dt);
+
+        Zeta::RigidBody2D* first = handler.getRigidBody(0);
+        for (int i = 0; i < count; ++i) { if (tracker.bodies[i] == first) { tracker.bodies[i] = nullptr; } }
+        handler.despawnRigidBody(first);
+
+        int misses = stepLOD(handler, tracker, 20, dt);
+
+        failed |= UNIT_TEST("Despawn Keeps LOD Phases", misses, 0);
+    }
+
+    return failed;
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <set>
+#include <utility>
+
+// * ===================================
+// * Observers
+// * ===================================
+
+typedef std::set<std::pair<int, void*>> VisibleSet; // (observer, body)
+
+// Build a grid of static boxes and rows of circles moving across it in both directions without gravity.
+static void buildObserverWorld(Zeta::Handler &handler) {
+    for (int i = 0; i < 64; ++i) {
+        ZMath::Vec2D pos(5.0f*(i % 8), 5.0f*(i / 8));
+        Zeta::AABB aabb(pos - 1, pos + 1);
+        handler.createStaticBody(pos, Zeta::STATIC_AABB_COLLIDER, &aabb);
+    }
+
+    for (int i = 0; i < 40; ++i) {
+        ZMath::Vec2D pos(2.0f*(i % 20) - 10, 2.5f + 10.0f*(i / 20) + 0.3f*i);
+        Zeta::Circle circle(pos, 0.5f);
+
+        Zeta::RigidBody2D* rb = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        rb->vel.set(i % 2 ? 12.0f : -9.0f, i % 3 ? 0.0f : 3.0f);
+        rb->sensor = 1; // keeps the rows from piling up on the boxes
+    }
+};
+
+// Apply the visibility events of the last call to update to a set of visible bodies.
+static void applyVisibilityEvents(Zeta::Handler &handler, VisibleSet &visible) {
+    int count;
+    Zeta::VisibilityEvent const* events = handler.getVisibilityEvents(count);
+
+    for (int i = 0; i < count; ++i) {
+        std::pair<int, void*> key(events[i].observer, events[i].body.body);
+
+        if (events[i].type == Zeta::VISIBILITY_ENTER) { visible.insert(key); }
+        else { visible.erase(key); }
+    }
+};
+
+// Count the differences between the bodies an observer can see, a fresh query of its view, and the set built from its events.
+static int countVisibleMismatches(Zeta::Handler &handler, int observer, Zeta::AABB const &view, VisibleSet const &visible) {
+    Zeta::BodyRef bodies[256];
+    Zeta::BodyRef queried[256];
+
+    int count = handler.getVisibleBodies(observer, bodies, 256);
+    int queriedCount = handler.queryAABB(view, queried, 256);
+
+    std::set<void*> a, b, c;
+    for (int i = 0; i < count; ++i) { a.insert(bodies[i].body); }
+    for (int i = 0; i < queriedCount; ++i) { b.insert(queried[i].body); }
+    for (auto const &key : visible) { if (key.first == observer) { c.insert(key.second); } }
+
+    return (a != b) + (a != c) + (count != (int) a.size());
+};
+
+bool observerTests() {
+    bool failed = 0;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildObserverWorld(handler);
+
+        // one view stays put while the other pans across the grid
+        Zeta::AABB still({8, 8}, {22, 22});
+        Zeta::AABB panning({-12, 0}, {0, 14});
+
+        int stillObserver = handler.addObserver(still);
+        int panningObserver = handler.addObserver(panning);
+
+        VisibleSet visible;
+        float dt = 0.0f;
+        int mismatches = 0;
+        int events = 0;
+
+        for (int i = 0; i < 90; ++i) {
+            if (i % 3 == 0) {
+                panning.pos.x += 0.7f;
+                handler.setObserverView(panningObserver, panning);
+            }
+
+            // add and remove a static body in the still view now and then
+            if (i == 30 || i == 60) {
+                ZMath::Vec2D pos(15, 15.0f + i/30);
+                Zeta::AABB aabb(pos - 0.5f, pos + 0.5f);
+                handler.createStaticBody(pos, Zeta::STATIC_AABB_COLLIDER, &aabb);
+            }
+
+            // removed bodies are dropped without an event
+            if (i == 45) {
+                Zeta::RigidBody2D* rb = handler.getRigidBody(3);
+                visible.erase({stillObserver, rb});
+                visible.erase({panningObserver, rb});
+                handler.removeRigidBody(rb);
+            }
+
+            // the observers are only updated by calls to update that step
+            dt += 1.0f/60.0f;
+            if (!handler.update(dt)) { continue; }
+
+            int count;
+            handler.getVisibilityEvents(count);
+            events += count;
+
+            applyVisibilityEvents(handler, visible);
+            mismatches += countVisibleMismatches(handler, stillObserver, still, visible);
+            mismatches += countVisibleMismatches(handler, panningObserver, panning, visible);
+        }
+
+        failed |= UNIT_TEST("Observers See Bodies Move", events > 0, 1);
+        failed |= UNIT_TEST("Visible Bodies Match Queries And Events", mismatches, 0);
+    }
+
+    {
+        // still views over resting bodies should not look at any body until one of them moves
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+
+        for (int i = 0; i < 40; ++i) {
+            ZMath::Vec2D pos(3.0f*(i % 8), 3.0f*(i / 8));
+            Zeta::Circle circle(pos, 0.5f);
+            handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        }
+
+        for (int i = 0; i < 3; ++i) { handler.addObserver(Zeta::AABB({5.0f*i - 1, -1}, {5.0f*i + 6, 13})); }
+
+        // the first update queries every view
+        for (int i = 0; i < 2; ++i) {
+            float dt = 1.0f/60.0f + 0.0001f;
+            handler.update(dt);
+        }
+
+        int restingTests = handler.getObserverBodyTests();
+        failed |= UNIT_TEST("Still Views Skip Resting Bodies", restingTests, 0);
+
+        handler.getRigidBody(9)->vel.set(6, 0);
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        int movingTests = handler.getObserverBodyTests();
+        failed |= UNIT_TEST("Still Views Only Test Moved Bodies", movingTests, 3);
+    }
+
+    return failed;
+};
@@ -0,0 +1,273 @@
+#pragma once
+
+// * ===================================
+// * World Queries
+// * ===================================
+
+// Build a cloud of circles and boxes flying apart from the origin without gravity, so the dynamic tree is refitted
+//  while it gets worse until it has to be rebuilt.
+static void buildQueryWorld(Zeta::Handler &handler) {
+    for (int i = 0; i < 120; ++i) {
+        ZMath::Vec2D pos(0.6f*(i % 12) - 3.3f, 0.6f*(i / 12) - 3.0f);
+
+        Zeta::RigidBody2D* rb;
+
+        if (i % 2) {
+            Zeta::Circle circle(pos, 0.25f);
+            rb = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        } else {
+            Zeta::Box2D box(pos - 0.2f, pos + 0.2f, 0.3f*i);
+            rb = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_BOX2D_COLLIDER, &box);
+        }
+
+        rb->vel = pos * 6.0f;
+        rb->sensor = 1; // keeps the cloud from colliding
+    }
+};
+
+// Count the bodies a query got wrong compared to testing every rigid body against the region.
+static int countQueryMismatches(Zeta::Handler &handler, Zeta::AABB const &region) {
+    Zeta::BodyRef bodies[256];
+    int count = handler.queryAABB(region, bodies, 256);
+
+    int expected = 0;
+
+    for (int i = 0; i < handler.getRigidBodyCount(); ++i) {
+        Zeta::BodyRef ref = {handler.getRigidBody(i), Zeta::RIGID_BODY};
+        if (!Zeta::BodyAndCollider(ref, Zeta::RIGID_AABB_COLLIDER, &region)) { continue; }
+
+        ++expected;
+
+        bool found = 0;
+        for (int j = 0; j < count && !found; ++j) { found = bodies[j].body == ref.body; }
+        if (!found) { return 1; }
+    }
+
+    return count != expected;
+};
+
+// Check a query found exactly the expected bodies in any order.
+static bool queryFound(Zeta::BodyRef const* bodies, int count, void* const* expected, int expectedCount) {
+    if (count != expectedCount) { return 0; }
+
+    for (int i = 0; i < expectedCount; ++i) {
+        bool found = 0;
+        for (int j = 0; j < count && !found; ++j) { found = bodies[j].body == expected[i]; }
+        if (!found) { return 0; }
+    }
+
+    return 1;
+};
+
+// Build a field of static, rigid, and kinematic bodies of every shape with a few sensors mixed in for raycasts.
+static void buildRaycastWorld(Zeta::Handler &handler) {
+    for (int i = 0; i < 90; ++i) {
+        ZMath::Vec2D pos(3.0f*(i % 10) - 13.5f + 0.37f*(i % 7), 3.0f*(i / 10) - 13.5f + 0.23f*(i % 5));
+        Zeta::Circle circle(pos, 0.4f + 0.1f*(i % 4));
+        Zeta::AABB aabb(pos - 0.5f, pos + ZMath::Vec2D(0.7f, 0.4f));
+        Zeta::Box2D box(pos - ZMath::Vec2D(0.8f, 0.3f), pos + ZMath::Vec2D(0.8f, 0.3f), 17.0f*i);
+
+        int shape = i % 3;
+
+        switch (i % 4) {
+            case 0: {
+                Zeta::StaticBodyCollider types[3] = {Zeta::STATIC_CIRCLE_COLLIDER, Zeta::STATIC_AABB_COLLIDER, Zeta::STATIC_BOX2D_COLLIDER};
+                void* colliders[3] = {&circle, &aabb, &box};
+                handler.createStaticBody(pos, types[shape], colliders[shape]);
+                break;
+            }
+
+            case 3: {
+                Zeta::KinematicBodyCollider types[3] = {Zeta::KINEMATIC_CIRCLE_COLLIDER, Zeta::KINEMATIC_AABB_COLLIDER, Zeta::KINEMATIC_BOX2D_COLLIDER};
+                void* colliders[3] = {&circle, &aabb, &box};
+                handler.createKinematicBody(pos, types[shape], colliders[shape]);
+                break;
+            }
+
+            default: {
+                Zeta::RigidBodyCollider types[3] = {Zeta::RIGID_CIRCLE_COLLIDER, Zeta::RIGID_AABB_COLLIDER, Zeta::RIGID_BOX2D_COLLIDER};
+                void* colliders[3] = {&circle, &aabb, &box};
+                handler.createRigidBody(pos, 1, 0.5f, 1.0f, types[shape], colliders[shape])->sensor = i % 9 == 1;
+                break;
+            }
+        }
+    }
+};
+
+// Count the rays in a fan whose packet raycast differs in any way from a scalar raycast.
+// count is deliberately not a multiple of the packet size so the last packet is partly empty.
+static int countPacketMismatches(Zeta::Handler &handler, ZMath::Vec2D const &origin, int count, float maxDist) {
+    Zeta::Ray2D* rays = (Zeta::Ray2D*) malloc(count*sizeof(Zeta::Ray2D));
+    Zeta::RaycastHit* hits = new Zeta::RaycastHit[count];
+
+    for (int i = 0; i < count; ++i) {
+        float angle = 6.2831853f*i/count + 0.01f;
+        new (&rays[i]) Zeta::Ray2D(origin, ZMath::Vec2D(cosf(angle), sinf(angle)));
+    }
+
+    int packetHits = handler.raycast(rays, count, hits, maxDist);
+    int scalarHits = 0, mismatches = 0;
+
+    for (int i = 0; i < count; ++i) {
+        Zeta::RaycastHit hit;
+        bool scalar = handler.raycast(rays[i], hit, maxDist);
+        scalarHits += scalar;
+
+        if (!scalar) { mismatches += hits[i].body.body != nullptr; continue; }
+
+        mismatches += hits[i].body.body != hit.body.body || hits[i].body.type != hit.body.type || hits[i].dist != hit.dist
+                      || hits[i].point != hit.point || hits[i].normal != hit.normal;
+    }
+
+    free(rays);
+    delete[] hits;
+
+    return mismatches + (packetHits != scalarHits);
+};
+
+bool queryTests() {
+    bool failed = 0;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildQueryWorld(handler);
+
+        float dt = 0.0f;
+        int mismatches = 0;
+
+        for (int i = 0; i < 60; ++i) {
+            dt += 1.0f/60.0f;
+            handler.update(dt);
+
+            // a window sweeping along with the cloud
+            float r = 0.2f*i;
+            mismatches += countQueryMismatches(handler, Zeta::AABB({r - 4, -2}, {r + 1, 3}));
+            mismatches += countQueryMismatches(handler, Zeta::AABB({-r - 2, -r - 2}, {-r + 2, -r + 2}));
+
+            if (i == 30) {
+                // bodies added and removed between queries rebuild the tree
+                handler.removeRigidBody(handler.getRigidBody(7));
+
+                ZMath::Vec2D pos(2, 2);
+                Zeta::Circle circle(pos, 0.5f);
+                handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle)->sensor = 1;
+            }
+        }
+
+        failed |= UNIT_TEST("Queries Match Brute Force While Refitting", mismatches, 0);
+    }
+
+    {
+        // one body of each kind around the origin, where each query has a known answer
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+
+        Zeta::AABB wall(ZMath::Vec2D(-1, -1), ZMath::Vec2D(1, 1));
+        void* sb = handler.createStaticBody(ZMath::Vec2D(0, 0), Zeta::STATIC_AABB_COLLIDER, &wall);
+
+        Zeta::Circle circle(ZMath::Vec2D(4, 0), 0.5f);
+        void* rb = handler.createRigidBody(circle.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        Zeta::Circle trigger(ZMath::Vec2D(0, 4), 0.5f);
+        Zeta::RigidBody2D* sensor = handler.createRigidBody(trigger.c, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &trigger);
+        sensor->sensor = 1;
+
+        // rotated onto a corner, so it reaches from -4.707 to -3.293 on each axis around its center
+        Zeta::Box2D diamond(ZMath::Vec2D(-4.5f, -0.5f), ZMath::Vec2D(-3.5f, 0.5f), 45.0f);
+        void* kb = handler.createKinematicBody(diamond.pos, Zeta::KINEMATIC_BOX2D_COLLIDER, &diamond);
+
+        Zeta::BodyRef bodies[8];
+
+        int count = handler.queryCircle(Zeta::Circle(ZMath::Vec2D(4, 1.2f), 0.8f), bodies, 8);
+        failed |= UNIT_TEST("Circle Query", queryFound(bodies, count, &rb, 1), 1);
+
+        // the bounds overlap the circle's, but the shapes are 1.27 apart against radii adding up to 1
+        count = handler.queryCircle(Zeta::Circle(ZMath::Vec2D(4.9f, 0.9f), 0.5f), bodies, 8);
+        failed |= UNIT_TEST("Circle Query Near Miss", count, 0);
+
+        count = handler.queryAABB(Zeta::AABB(ZMath::Vec2D(-0.5f, 3.4f), ZMath::Vec2D(0.5f, 4.2f)), bodies, 8);
+        void* sensors[1] = {sensor};
+        failed |= UNIT_TEST("AABB Query Includes Sensors", queryFound(bodies, count, sensors, 1), 1);
+
+        count = handler.queryAABB(Zeta::AABB(ZMath::Vec2D(-3.5f, -0.5f), ZMath::Vec2D(3.6f, 0.5f)), bodies, 8);
+        void* row[3] = {sb, rb, kb};
+        failed |= UNIT_TEST("AABB Query", queryFound(bodies, count, row, 3), 1);
+
+        count = handler.queryBox(Zeta::Box2D(ZMath::Vec2D(-3.4f, -0.2f), ZMath::Vec2D(-3.0f, 0.2f), 0.0f), bodies, 8);
+        failed |= UNIT_TEST("Box Query", queryFound(bodies, count, &kb, 1), 1);
+
+        // inside the diamond's bounds, but past its edge
+        count = handler.queryBox(Zeta::Box2D(ZMath::Vec2D(-3.45f, 0.45f), ZMath::Vec2D(-3.05f, 0.85f), 0.0f), bodies, 8);
+        failed |= UNIT_TEST("Box Query Near Miss", count, 0);
+
+        // a rotated query reaching the wall's corner only when it is close enough
+        count = handler.queryBox(Zeta::Box2D(ZMath::Vec2D(0.8f, 0.8f), ZMath::Vec2D(1.8f, 1.8f), 45.0f), bodies, 8);
+        failed |= UNIT_TEST("Rotated Box Query", queryFound(bodies, count, &sb, 1), 1);
+
+        count = handler.queryBox(Zeta::Box2D(ZMath::Vec2D(0.9f, 0.9f), ZMath::Vec2D(1.9f, 1.9f), 45.0f), bodies, 8);
+        failed |= UNIT_TEST("Rotated Box Query Near Miss", count, 0);
+
+        // results past capacity are dropped without writing past the buffer
+        Zeta::AABB everything(ZMath::Vec2D(-10, -10), ZMath::Vec2D(10, 10));
+        count = handler.queryAABB(everything, bodies, 8);
+        void* all[4] = {sb, rb, sensor, kb};
+        failed |= UNIT_TEST("Query Finds Everything", queryFound(bodies, count, all, 4), 1);
+
+        bodies[2].body = nullptr;
+        count = handler.queryAABB(everything, bodies, 2);
+
+        bool distinct = bodies[0].body != bodies[1].body && bodies[0].body && bodies[1].body;
+        failed |= UNIT_TEST("Query Drops Past Capacity", count == 2 && distinct && !bodies[2].body, 1);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        buildRaycastWorld(handler);
+
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        int mismatches = 0;
+
+        // fans from inside and outside the field, including origins inside bodies, with short and unlimited ranges
+        for (int i = 0; i < 12; ++i) {
+            ZMath::Vec2D origin(5.1f*i - 30.0f, 3.7f*i - 20.0f);
+            mismatches += countPacketMismatches(handler, origin, 61, 8.0f);
+            mismatches += countPacketMismatches(handler, origin, 38, FLT_MAX);
+        }
+
+        for (int i = 0; i < handler.getStaticBodyCount(); i += 5) {
+            mismatches += countPacketMismatches(handler, handler.getStaticBody(i)->pos, 7, FLT_MAX);
+        }
+
+        failed |= UNIT_TEST("Packet Raycasts Match Scalar Raycasts", mismatches, 0);
+    }
+
+    {
+        // flat and zero radius shapes skimming the top of a large circle spend most of the sweep inside its bounds
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+
+        Zeta::Circle hill(ZMath::Vec2D(0, 0), 100);
+        handler.createStaticBody(hill.c, Zeta::STATIC_CIRCLE_COLLIDER, &hill);
+
+        float expected = 150.0f - sqrtf(100.0f*100.0f - 99.0f*99.0f);
+
+        Zeta::AABB flat(ZMath::Vec2D(-150.5f, 99), ZMath::Vec2D(-149.5f, 99));
+        Zeta::ShapecastHit hit;
+        bool hitFlat = handler.shapecast(flat, ZMath::Vec2D(1, 0), hit, 1000.0f);
+        float dist = hit.dist;
+        failed |= UNIT_TEST("Flat Shapecast", hitFlat && fabsf(dist - (expected - 0.5f)) < 0.01f, 1);
+
+        Zeta::Circle point(ZMath::Vec2D(-150, 99), 0);
+        bool hitPoint = handler.shapecast(point, ZMath::Vec2D(1, 0), hit, 1000.0f);
+        dist = hit.dist;
+        failed |= UNIT_TEST("Zero Radius Shapecast", hitPoint && fabsf(dist - expected) < 0.01f, 1);
+
+        // just over the top
+        point.c.set(-150, 100.5f);
+        bool miss = !handler.shapecast(point, ZMath::Vec2D(1, 0), hit, 1000.0f);
+        failed |= UNIT_TEST("Zero Radius Shapecast Miss", miss, 1);
+    }
+
+    return failed;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+// * ===================================
+// * Recordings
+// * ===================================
+
+// Replay a whole recording into a fresh handler and return its checksum.
+static unsigned long long replayChecksum(Zeta::Recorder const &recorder, bool &valid) {
+    Zeta::RecordReader reader;
+    Zeta::Record record;
+
+    valid = reader.open(recorder.getData(), recorder.getSize()) && reader.next(record) && record.type == Zeta::RECORD_SETTINGS;
+    if (!valid) { return 0; }
+
+    Zeta::Handler handler(record.settings.g, record.settings.updateStep);
+    Zeta::replayRecord(handler, record);
+
+    while (reader.next(record)) { Zeta::replayRecord(handler, record); }
+
+    return handler.getChecksum();
+};
+
+bool recorderTests() {
+    bool failed = 0;
+
+    {
+        // record a world that is built before recording starts, has bodies added, removed, and pushed, and changes its settings
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+
+        Zeta::Recorder recorder;
+        handler.setRecorder(&recorder);
+
+        float dt = 0.0f;
+
+        for (int i = 0; i < 120; ++i) {
+            if (i == 20) {
+                ZMath::Vec2D pos(1, 8);
+                Zeta::Circle circle(pos, 0.75f);
+                handler.createRigidBody(pos, 2, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+            }
+
+            if (i == 40) { handler.removeRigidBody(handler.getRigidBody(2)); }
+            if (i == 60) { handler.reorderInterval = 5; }
+
+            if (i % 10 == 0) {
+                Zeta::AABB kick(ZMath::Vec2D(-1.0f + 0.1f*i, 5), ZMath::Vec2D(1.0f + 0.1f*i, 6));
+                handler.createKinematicBody(kick.pos, Zeta::KINEMATIC_AABB_COLLIDER, &kick);
+            }
+
+            handler.getRigidBody(i % handler.getRigidBodyCount())->netForce.set(40.0f, 20.0f);
+
+            // uneven frame times so some calls run no steps and some run several
+            dt += (i % 4 ? 1.0f/90.0f : 1.0f/30.0f);
+            handler.update(dt);
+        }
+
+        handler.setRecorder(nullptr);
+
+        bool valid;
+        unsigned long long replayed = replayChecksum(recorder, valid);
+        unsigned long long recorded = handler.getChecksum();
+
+        failed |= UNIT_TEST("Recording Is Valid", valid, 1);
+        failed |= UNIT_TEST("Replay Matches The Recorded Run", replayed == recorded, 1);
+    }
+
+    return failed;
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+// * ===================================
+// * Replication
+// * ===================================
+
+// Build a row of circles drifting apart without gravity. Every third body starts at rest so some bodies are skipped.
+static void buildReplicationWorld(Zeta::Handler &handler, Zeta::RigidBody2D** bodies, int count) {
+    for (int i = 0; i < count; ++i) {
+        ZMath::Vec2D pos(3.0f*i - 20.0f, 0.5f*i);
+        Zeta::Circle circle(pos, 1);
+
+        bodies[i] = handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+        bodies[i]->sensor = 1; // keeps the bodies from colliding
+
+        if (i % 3) { bodies[i]->vel.set(0.37f*i - 2.0f, 1.3f - 0.21f*i); }
+    }
+};
+
+// Count the bodies a decoder got wrong compared to the handler. A body is wrong if it is off by more than the precision.
+static int countReplicationErrors(Zeta::Handler &handler, Zeta::ReplicationDecoder const &decoder) {
+    int count = handler.getRigidBodyCount();
+    if (decoder.getBodyCount() != count) { return count + 1; }
+
+    int errors = 0;
+
+    for (int i = 0; i < count; ++i) {
+        ZMath::Vec2D pos, vel;
+        decoder.getState(i, pos, vel);
+
+        Zeta::RigidBody2D const* rb = handler.getRigidBody(i);
+        ZMath::Vec2D dp = ZMath::abs(pos - rb->pos), dv = ZMath::abs(vel - rb->vel);
+
+        errors += dp.x > 0.006f || dp.y > 0.006f || dv.x > 0.006f || dv.y > 0.006f;
+    }
+
+    return errors;
+};
+
+// Capture, encode, and decode one tick for a client. Returns the size of the packet or 0 if it failed.
+static size_t replicate(Zeta::ReplicationEncoder &encoder, int client, Zeta::ReplicationDecoder &decoder) {
+    uint8_t buffer[1024];
+
+    size_t size = encoder.encode(client, buffer, sizeof(buffer));
+    if (!size || !decoder.decode(buffer, size)) { return 0; }
+
+    return size;
+};
+
+// Step a handler and replicate every step to two clients.
+// Returns the number of wrong bodies summed over both clients and every step.
+// change is called with the step number before each step to change the bodies' indices.
+static int runReplication(Zeta::Handler &handler, int steps, void (*change)(Zeta::Handler&, Zeta::ReplicationEncoder&, int)) {
+    Zeta::ReplicationEncoder encoder;
+    Zeta::ReplicationDecoder decoders[2];
+    int clients[2] = {encoder.addClient(), encoder.addClient()};
+    int errors = 0;
+
+    for (int step = 0; step < steps; ++step) {
+        if (change) { change(handler, encoder, step); }
+
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+
+        encoder.capture(handler);
+
+        for (int c = 0; c < 2; ++c) {
+            if (!replicate(encoder, clients[c], decoders[c])) { return -1; }
+            errors += countReplicationErrors(handler, decoders[c]);
+        }
+    }
+
+    return errors;
+};
+
+// Pack bits least significant bit first, like the encoder. Returns the number of bytes used.
+static size_t packBits(uint8_t* buffer, int const* values, int const* bits, int n) {
+    uint64_t scratch = 0;
+    int used = 0;
+
+    for (int i = 0; i < n; ++i) {
+        scratch |= (uint64_t) (uint32_t) values[i] << used;
+        used += bits[i];
+    }
+
+    size_t size = (used + 7)/8;
+    for (size_t i = 0; i < size; ++i) { buffer[i] = (uint8_t) (scratch >> 8*i); }
+
+    return size;
+};
+
+bool replicationTests() {
+    bool failed = 0;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[24];
+        buildReplicationWorld(handler, bodies, 24);
+
+        int errors = runReplication(handler, 40, nullptr);
+        failed |= UNIT_TEST("Round Trip", errors, 0);
+    }
+
+    {
+        // bodies at rest cost nothing after the first packet: 32 bit count, full flag, and a changed count of 0
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[6];
+        buildReplicationWorld(handler, bodies, 6);
+        for (int i = 0; i < 6; ++i) { bodies[i]->vel.zero(); }
+
+        Zeta::ReplicationEncoder encoder;
+        Zeta::ReplicationDecoder decoder;
+        int client = encoder.addClient();
+
+        encoder.capture(handler);
+        size_t first = replicate(encoder, client, decoder);
+        encoder.capture(handler);
+        size_t second = replicate(encoder, client, decoder);
+
+        failed |= UNIT_TEST("First Packet Sends Every Body", first > 5, 1);
+        failed |= UNIT_TEST("Bodies At Rest Are Skipped", second, 5);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[24];
+        buildReplicationWorld(handler, bodies, 24);
+
+        int errors = runReplication(handler, 30, [](Zeta::Handler&, Zeta::ReplicationEncoder &encoder, int step) {
+            if (step == 10 || step == 11 || step == 20) { encoder.resetClient(step % 2); }
+        });
+
+        failed |= UNIT_TEST("Reset Client Round Trip", errors, 0);
+    }
+
+    {
+        // despawning moves the last body into the despawned body's index
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[24];
+        buildReplicationWorld(handler, bodies, 24);
+
+        int errors = runReplication(handler, 30, [](Zeta::Handler &handler, Zeta::ReplicationEncoder&, int step) {
+            if (step % 10 == 5) { handler.despawnRigidBody(handler.getRigidBody(1)); }
+        });
+
+        failed |= UNIT_TEST("Despawn Round Trip", errors, 0);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[24];
+        buildReplicationWorld(handler, bodies, 24);
+        handler.reorderInterval = 7;
+
+        int errors = runReplication(handler, 30, nullptr);
+        failed |= UNIT_TEST("Reorder Round Trip", errors, 0);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[24];
+        buildReplicationWorld(handler, bodies, 24);
+
+        Zeta::ReplicationEncoder encoder;
+        Zeta::ReplicationDecoder decoder;
+        int client = encoder.addClient();
+        uint8_t buffer[1024];
+
+        encoder.capture(handler);
+        size_t size = encoder.encode(client, buffer, 8);
+        failed |= UNIT_TEST("Encode Into Small Buffer", size, 0);
+
+        // the baseline was left alone, so the next packet still has every body
+        size = replicate(encoder, client, decoder);
+        int errors = countReplicationErrors(handler, decoder);
+        failed |= UNIT_TEST("Encode After Small Buffer", size > 8 && !errors, 1);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, 0));
+        Zeta::RigidBody2D* bodies[24];
+        buildReplicationWorld(handler, bodies, 24);
+
+        Zeta::ReplicationEncoder encoder;
+        Zeta::ReplicationDecoder decoder;
+        int client = encoder.addClient();
+        uint8_t buffer[1024];
+
+        encoder.capture(handler);
+        replicate(encoder, client, decoder);
+
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+        handler.update(dt);
+        encoder.capture(handler);
+        size_t size = encoder.encode(client, buffer, sizeof(buffer));
+
+        ZMath::Vec2D before, vel;
+        decoder.getState(4, before, vel);
+
+        bool applied = decoder.decode(buffer, size - 1);
+        failed |= UNIT_TEST("Truncated Packet Is Rejected", applied, 0);
+
+        ZMath::Vec2D after;
+        decoder.getState(4, after, vel);
+        int count = decoder.getBodyCount();
+        failed |= UNIT_TEST("Rejected Packet Leaves State Unchanged", before == after && count == 24, 1);
+
+        applied = decoder.decode(buffer, 0);
+        failed |= UNIT_TEST("Empty Packet Is Rejected", applied, 0);
+
+        applied = decoder.decode(buffer, size);
+        int errors = countReplicationErrors(handler, decoder);
+        failed |= UNIT_TEST("Packet Applies After Rejection", applied && !errors, 1);
+    }
+
+    {
+        Zeta::ReplicationDecoder decoder;
+        uint8_t buffer[16];
+
+        // count 2, not full, 1 changed body, but it skips past the end of the list
+        int values[] = {2, 0, 1, 1, 1, 5};
+        int bits[] = {32, 1, 2, 6, 2, 6};
+        size_t size = packBits(buffer, values, bits, 6);
+
+        bool applied = decoder.decode(buffer, size);
+        failed |= UNIT_TEST("Index Out Of Range Is Rejected", applied, 0);
+
+        // count 2, not full, but 3 changed bodies
+        int values2[] = {2, 0, 1, 3};
+        int bits2[] = {32, 1, 2, 6};
+        size = packBits(buffer, values2, bits2, 4);
+
+        applied = decoder.decode(buffer, size);
+        failed |= UNIT_TEST("More Changes Than Bodies Is Rejected", applied, 0);
+        failed |= UNIT_TEST("Rejected Packets Add No Bodies", decoder.getBodyCount(), 0);
+    }
+
+    return failed;
+};
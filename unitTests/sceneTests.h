@@ -0,0 +1,173 @@
+#pragma once
+
+// * ===================================
+// * Scene Files
+// * ===================================
+
+static const char* SCENE_TEST_PATH = "sceneTest.zscn";
+static const char* SCENE_RESAVE_PATH = "sceneTestResaved.zscn";
+
+// Fill a handler with a grid of static circles, AABBs, and boxes plus a static body without a collider.
+static void buildScene(Zeta::Handler &handler) {
+    for (int i = 0; i < 60; ++i) {
+        ZMath::Vec2D pos(4.0f*(i % 10), 4.0f*(i / 10));
+        Zeta::StaticBody2D* sb;
+
+        if (i % 3 == 0) {
+            Zeta::Circle circle(pos, 1);
+            sb = new Zeta::StaticBody2D(pos, Zeta::STATIC_CIRCLE_COLLIDER, &circle);
+
+        } else if (i % 3 == 1) {
+            Zeta::AABB aabb(pos - 1, pos + 1);
+            sb = new Zeta::StaticBody2D(pos, Zeta::STATIC_AABB_COLLIDER, &aabb);
+
+        } else {
+            Zeta::Box2D box(pos - ZMath::Vec2D(1.5f, 0.5f), pos + ZMath::Vec2D(1.5f, 0.5f), 10.0f*i);
+            sb = new Zeta::StaticBody2D(pos, Zeta::STATIC_BOX2D_COLLIDER, &box);
+        }
+
+        sb->sensor = i == 7;
+        handler.addStaticBody(sb);
+    }
+
+    handler.addStaticBody(new Zeta::StaticBody2D(ZMath::Vec2D(-10, -10), Zeta::STATIC_NONE, nullptr));
+};
+
+// Count the static bodies of one handler that have no identical body in the other.
+static int countSceneMismatches(Zeta::Handler &a, Zeta::Handler &b) {
+    if (a.getStaticBodyCount() != b.getStaticBodyCount()) { return a.getStaticBodyCount() + 1; }
+
+    int mismatches = 0;
+
+    for (int i = 0; i < a.getStaticBodyCount(); ++i) {
+        Zeta::StaticBody2D const* sa = a.getStaticBody(i);
+        bool found = 0;
+
+        for (int j = 0; j < b.getStaticBodyCount() && !found; ++j) {
+            Zeta::StaticBody2D const* sb = b.getStaticBody(j);
+
+            found = sa->pos == sb->pos && sa->colliderType == sb->colliderType && sa->sensor == sb->sensor
+                    && sa->boundsMin == sb->boundsMin && sa->boundsMax == sb->boundsMax;
+        }
+
+        mismatches += !found;
+    }
+
+    return mismatches;
+};
+
+// Count the rays that hit a different body or at a different distance in two handlers.
+static int countRaycastMismatches(Zeta::Handler &a, Zeta::Handler &b) {
+    int mismatches = 0;
+
+    for (int i = 0; i < 32; ++i) {
+        float angle = 0.2f*i;
+        Zeta::Ray2D ray(ZMath::Vec2D(18, 10), ZMath::Vec2D(cosf(angle), sinf(angle)));
+
+        Zeta::RaycastHit ha, hb;
+        bool hitA = a.raycast(ray, ha), hitB = b.raycast(ray, hb);
+
+        if (hitA != hitB) { ++mismatches; continue; }
+        if (!hitA) { continue; }
+
+        Zeta::StaticBody2D const* sa = (Zeta::StaticBody2D const*) ha.body.body;
+        Zeta::StaticBody2D const* sb = (Zeta::StaticBody2D const*) hb.body.body;
+
+        mismatches += sa->pos != sb->pos || ha.dist != hb.dist;
+    }
+
+    return mismatches;
+};
+
+bool sceneTests() {
+    bool failed = 0;
+
+    {
+        Zeta::Handler original;
+        buildScene(original);
+
+        bool saved = original.saveScene(SCENE_TEST_PATH);
+        failed |= UNIT_TEST("Save Scene", saved, 1);
+
+        Zeta::Handler loaded;
+        bool load = loaded.loadScene(SCENE_TEST_PATH);
+        failed |= UNIT_TEST("Load Scene", load, 1);
+
+        int mismatches = countSceneMismatches(original, loaded);
+        failed |= UNIT_TEST("Loaded Bodies Match Saved Bodies", mismatches, 0);
+
+        mismatches = countRaycastMismatches(original, loaded);
+        failed |= UNIT_TEST("Loaded Tree Matches Built Tree", mismatches, 0);
+
+        // a scene saved from a loaded scene is the same scene
+        bool resaved = loaded.saveScene(SCENE_RESAVE_PATH);
+
+        Zeta::Handler reloaded;
+        load = reloaded.loadScene(SCENE_RESAVE_PATH);
+        mismatches = countSceneMismatches(original, reloaded) + countRaycastMismatches(original, reloaded);
+        failed |= UNIT_TEST("Resaved Scene Round Trip", resaved && load && !mismatches, 1);
+
+#ifndef _WIN32
+        // saving over the file a handler is mapped from leaves its bodies intact (Windows refuses to replace a mapped file)
+        resaved = loaded.saveScene(SCENE_TEST_PATH);
+        mismatches = countSceneMismatches(original, loaded);
+        failed |= UNIT_TEST("Save Over Loaded Scene", resaved && !mismatches, 1);
+#endif
+
+        load = loaded.loadScene(SCENE_TEST_PATH);
+        failed |= UNIT_TEST("Second Scene Is Rejected", load, 0);
+    }
+
+    {
+        // keep only half of a valid file
+        Zeta::Handler original;
+        buildScene(original);
+        original.saveScene(SCENE_TEST_PATH);
+
+        FILE* file = fopen(SCENE_TEST_PATH, "rb");
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        char* data = new char[size];
+        size_t read = fread(data, 1, size, file);
+        fclose(file);
+
+        file = fopen(SCENE_TEST_PATH, "wb");
+        fwrite(data, 1, read/2, file);
+        fclose(file);
+
+        Zeta::Handler truncated;
+        bool load = truncated.loadScene(SCENE_TEST_PATH);
+        failed |= UNIT_TEST("Truncated Scene Is Rejected", load, 0);
+
+        // break a node's child index
+        Zeta::SceneHeader const* header = (Zeta::SceneHeader const*) data;
+        Zeta::BVHNode* nodes = (Zeta::BVHNode*) (data + header->nodesOffset);
+        nodes[0].left = header->nodeCount + 5;
+
+        file = fopen(SCENE_TEST_PATH, "wb");
+        fwrite(data, 1, read, file);
+        fclose(file);
+
+        Zeta::Handler corrupt;
+        load = corrupt.loadScene(SCENE_TEST_PATH);
+        failed |= UNIT_TEST("Corrupt Tree Is Rejected", load, 0);
+
+        delete[] data;
+
+        // the handler is still usable after a failed load
+        original.saveScene(SCENE_TEST_PATH);
+        load = corrupt.loadScene(SCENE_TEST_PATH);
+        failed |= UNIT_TEST("Load After Rejected Scene", load, 1);
+
+        Zeta::Handler missing;
+        load = missing.loadScene("missingScene.zscn");
+        failed |= UNIT_TEST("Missing Scene Is Rejected", load, 0);
+    }
+
+    remove(SCENE_TEST_PATH);
+    remove(SCENE_RESAVE_PATH);
+
+    return failed;
+};
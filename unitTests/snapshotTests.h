@@ -0,0 +1,148 @@
+#pragma once
+
+// * ===================================
+// * Snapshots
+// * ===================================
+
+// Build a handful of circles falling onto a floor.
+static void buildSnapshotWorld(Zeta::Handler &handler) {
+    Zeta::AABB floor(ZMath::Vec2D(-20, -1), ZMath::Vec2D(20, 0));
+    handler.createStaticBody(floor.pos, Zeta::STATIC_AABB_COLLIDER, &floor);
+
+    for (int i = 0; i < 8; ++i) {
+        ZMath::Vec2D pos(2.5f*i - 9.0f, 1.0f + 0.7f*i);
+        Zeta::Circle circle(pos, 0.5f);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle)->vel.set(3.0f - i, 0);
+    }
+};
+
+// Step a handler a number of times.
+static void stepSnapshotWorld(Zeta::Handler &handler, int steps) {
+    for (int i = 0; i < steps; ++i) {
+        float dt = 1.0f/60.0f + 0.0001f;
+        handler.update(dt);
+    }
+};
+
+bool snapshotTests() {
+    bool failed = 0;
+    char buffer[8192];
+
+    {
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+        stepSnapshotWorld(handler, 5);
+
+        size_t size = handler.saveSnapshot(buffer, sizeof(buffer));
+        unsigned long long saved = handler.getChecksum();
+
+        stepSnapshotWorld(handler, 20);
+
+        bool restored = handler.restoreSnapshot(buffer, size);
+        unsigned long long checksum = handler.getChecksum();
+        failed |= UNIT_TEST("Restore Snapshot", restored && checksum == saved, 1);
+
+        // restoring does not change the bodies held, so the snapshot can be restored again
+        stepSnapshotWorld(handler, 3);
+        restored = handler.restoreSnapshot(buffer, size);
+        checksum = handler.getChecksum();
+        failed |= UNIT_TEST("Restore Snapshot Twice", restored && checksum == saved, 1);
+
+        restored = handler.restoreSnapshot(buffer, size - 1);
+        failed |= UNIT_TEST("Wrong Size Is Rejected", restored, 0);
+    }
+
+    {
+        // reordering only changes the indices of the same bodies
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+        handler.reorderInterval = 1;
+        stepSnapshotWorld(handler, 5);
+
+        size_t size = handler.saveSnapshot(buffer, sizeof(buffer));
+        Zeta::RigidBody2D* first = handler.getRigidBody(0);
+        unsigned long long saved = handler.getChecksum();
+
+        stepSnapshotWorld(handler, 20);
+
+        bool restored = handler.restoreSnapshot(buffer, size);
+        unsigned long long checksum = handler.getChecksum();
+        failed |= UNIT_TEST("Restore Across Reorders", restored && checksum == saved && handler.getRigidBody(0) == first, 1);
+    }
+
+    {
+        // the same number of bodies, but one of them is a different body
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+        stepSnapshotWorld(handler, 5);
+
+        size_t size = handler.saveSnapshot(buffer, sizeof(buffer));
+
+        handler.removeRigidBody(handler.getRigidBody(3));
+
+        ZMath::Vec2D pos(0, 10);
+        Zeta::Circle circle(pos, 0.5f);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        unsigned long long before = handler.getChecksum();
+        bool restored = handler.restoreSnapshot(buffer, size);
+        unsigned long long after = handler.getChecksum();
+
+        failed |= UNIT_TEST("Remove And Add Is Rejected", restored, 0);
+        failed |= UNIT_TEST("Rejected Snapshot Changes Nothing", after == before, 1);
+    }
+
+    {
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+
+        int pool = handler.createRigidBodyPool(4);
+        ZMath::Vec2D pos(0, 10);
+        Zeta::Circle circle(pos, 0.5f);
+        Zeta::RigidBody2D body(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+
+        Zeta::RigidBody2D* spawned = handler.spawnRigidBody(pool, body);
+        stepSnapshotWorld(handler, 5);
+
+        size_t size = handler.saveSnapshot(buffer, sizeof(buffer));
+
+        // the pool hands the same slot back, so even the pointers match
+        handler.despawnRigidBody(spawned);
+        Zeta::RigidBody2D* respawned = handler.spawnRigidBody(pool, body);
+
+        bool restored = handler.restoreSnapshot(buffer, size);
+        failed |= UNIT_TEST("Despawn And Spawn Is Rejected", restored, 0);
+        failed |= UNIT_TEST("Pool Reuses The Slot", respawned == spawned, 1);
+    }
+
+    {
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+        size_t size = handler.saveSnapshot(buffer, sizeof(buffer));
+
+        Zeta::AABB wall(ZMath::Vec2D(20, 0), ZMath::Vec2D(21, 10));
+        Zeta::StaticBody2D* sb = handler.createStaticBody(wall.pos, Zeta::STATIC_AABB_COLLIDER, &wall);
+        handler.removeStaticBody(sb);
+
+        bool restored = handler.restoreSnapshot(buffer, size);
+        failed |= UNIT_TEST("Static Add And Remove Is Rejected", restored, 0);
+    }
+
+    {
+        // static bodies are left out of snapshots, so restoring never writes to them
+        Zeta::Handler handler;
+        buildSnapshotWorld(handler);
+        stepSnapshotWorld(handler, 5);
+
+        size_t size = handler.saveSnapshot(buffer, sizeof(buffer));
+        Zeta::StaticBody2D* floor = handler.getStaticBody(0);
+        floor->sensor = 1;
+
+        stepSnapshotWorld(handler, 5);
+
+        bool restored = handler.restoreSnapshot(buffer, size);
+        failed |= UNIT_TEST("Static Bodies Are Not Restored", restored && floor->sensor, 1);
+    }
+
+    return failed;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+// * ===================================
+// * Step Limits
+// * ===================================
+
+// Build a few falling circles and set the step limits.
+static void buildStepLimitWorld(Zeta::Handler &handler, int maxSteps, float stepBudget, Zeta::StepLimitMode mode) {
+    for (int i = 0; i < 8; ++i) {
+        ZMath::Vec2D pos(3.0f*i, 0);
+        Zeta::Circle circle(pos, 1);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle);
+    }
+
+    handler.maxSteps = maxSteps;
+    handler.stepBudget = stepBudget;
+    handler.stepLimitMode = mode;
+};
+
+// Call update with 10.25 steps worth of time, then with one step more.
+// Returns the steps taken by the first call and sets the time it skipped, the time it left in dt, and the steps of the second call.
+static int stepPastLimit(Zeta::Handler &handler, float &skipped, float &leftover, int &nextSteps) {
+    float dt = 10.25f*FPS_60;
+    int steps = handler.update(dt);
+
+    skipped = handler.getSkippedTime();
+    leftover = dt;
+
+    // the skipped time is gone, so the next call does not try to catch up
+    dt += FPS_60;
+    nextSteps = handler.update(dt);
+
+    return steps;
+};
+
+bool stepLimitTests() {
+    bool failed = 0;
+    float skipped, leftover;
+    int nextSteps;
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f), FPS_60);
+        buildStepLimitWorld(handler, 3, 0.0f, Zeta::DROP_TIME);
+
+        int steps = stepPastLimit(handler, skipped, leftover, nextSteps);
+        failed |= UNIT_TEST("Max Steps Caps The Steps", steps, 3);
+        failed |= UNIT_TEST("Max Steps Reports The Skipped Time", fabsf(skipped - 7*FPS_60) < 1e-4f, 1);
+        failed |= UNIT_TEST("Max Steps Keeps The Partial Step", fabsf(leftover - 0.25f*FPS_60) < 1e-4f, 1);
+        failed |= UNIT_TEST("Max Steps Drops The Skipped Time", nextSteps, 1);
+    }
+
+    {
+        // whole steps past maxSteps are skipped whatever the mode
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f), FPS_60);
+        buildStepLimitWorld(handler, 3, 0.0f, Zeta::REDUCE_ITERATIONS);
+
+        int steps = stepPastLimit(handler, skipped, leftover, nextSteps);
+        failed |= UNIT_TEST("Max Steps Caps Reduced Iterations", steps == 3 && fabsf(skipped - 7*FPS_60) < 1e-4f, 1);
+    }
+
+    {
+        // a budget no step fits in still runs the first step
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f), FPS_60);
+        buildStepLimitWorld(handler, 0, 1e-9f, Zeta::DROP_TIME);
+
+        int steps = stepPastLimit(handler, skipped, leftover, nextSteps);
+        failed |= UNIT_TEST("Step Budget Caps The Steps", steps, 1);
+        failed |= UNIT_TEST("Step Budget Reports The Skipped Time", fabsf(skipped - 9*FPS_60) < 1e-4f, 1);
+        failed |= UNIT_TEST("Step Budget Keeps The Partial Step", fabsf(leftover - 0.25f*FPS_60) < 1e-4f, 1);
+        failed |= UNIT_TEST("Step Budget Drops The Skipped Time", nextSteps, 1);
+    }
+
+    {
+        Zeta::Handler handler(ZMath::Vec2D(0, -9.8f), FPS_60);
+        buildStepLimitWorld(handler, 0, 1e-9f, Zeta::REDUCE_ITERATIONS);
+
+        int steps = stepPastLimit(handler, skipped, leftover, nextSteps);
+        failed |= UNIT_TEST("Step Budget Reduces Iterations Instead", steps == 10 && skipped == 0.0f, 1);
+    }
+
+    return failed;
+};
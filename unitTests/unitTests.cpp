@@ -1,6 +1,40 @@
+#include <ZETA/physicshandler.h>
+#include <ZETA/replication.h>
+#include <ZETA/scene.h>
+#include <ZETA/worldbatch.h>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <string>
 
+// * ===================================
+// * Allocation Tracking
+// * ===================================
+
+// ? Every allocation in the test binary goes through these, so a test can check that a section of code never touches the heap.
+
+long long allocationCount = 0; // allocations made while countAllocations is set
+bool countAllocations = 0;
+
+void* operator new(std::size_t size) {
+    if (countAllocations) { ++allocationCount; }
+
+    void* p = malloc(size ? size : 1);
+    if (!p) { throw std::bad_alloc(); }
+
+    return p;
+};
+
+void* operator new[](std::size_t size) { return operator new(size); };
+
+// ? Every form of delete forwards to the plain one so they all release with free, matching the malloc in operator new.
+// ? The sized forms leave the size unnamed since free does not need it.
+void operator delete(void* p) noexcept { free(p); };
+void operator delete[](void* p) noexcept { operator delete(p); };
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); };
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); };
+
 // Macro for unit testing.
 #define UNIT_TEST(test, obtained, expected) \
 ({ \
@@ -43,3 +77,41 @@ bool testCases(std::string const &test, bool (*func)()) {
     std::cout << "\n================ [PASSED] " << test << ". ================\n\n";
     return 0;
 };
+
+#include "allocationTests.h"
+#include "eventTests.h"
+#include "lodTests.h"
+#include "interpolationTests.h"
+#include "observerTests.h"
+#include "queryTests.h"
+#include "replicationTests.h"
+#include "sceneTests.h"
+#include "snapshotTests.h"
+#include "continuousTests.h"
+#include "boundsTests.h"
+#include "determinismTests.h"
+#include "stepLimitTests.h"
+#include "worldBatchTests.h"
+#include "recorderTests.h"
+
+int main() {
+    bool failed = 0;
+
+    failed |= testCases("Allocation", allocationTests);
+    failed |= testCases("Event", eventTests);
+    failed |= testCases("LOD", lodTests);
+    failed |= testCases("Interpolation", interpolationTests);
+    failed |= testCases("Observer", observerTests);
+    failed |= testCases("Query", queryTests);
+    failed |= testCases("Replication", replicationTests);
+    failed |= testCases("Scene", sceneTests);
+    failed |= testCases("Snapshot", snapshotTests);
+    failed |= testCases("Continuous Collision", continuousTests);
+    failed |= testCases("Cached Bounds", boundsTests);
+    failed |= testCases("Determinism", determinismTests);
+    failed |= testCases("Step Limit", stepLimitTests);
+    failed |= testCases("World Batch", worldBatchTests);
+    failed |= testCases("Recorder", recorderTests);
+
+    return failed;
+};
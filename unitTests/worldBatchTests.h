@@ -0,0 +1,62 @@
+#pragma once
+
+// * ===================================
+// * World Batches
+// * ===================================
+
+// Build a world of circles falling onto a floor. Each seed gives a different number of bodies moving a different way.
+static void buildBatchWorld(Zeta::Handler &handler, int seed) {
+    Zeta::AABB floor(ZMath::Vec2D(-30, -1), ZMath::Vec2D(30, 0));
+    handler.createStaticBody(floor.pos, Zeta::STATIC_AABB_COLLIDER, &floor);
+
+    for (int i = 0; i < 4 + 3*seed; ++i) {
+        ZMath::Vec2D pos(2.5f*(i % 10) - 12.0f, 1.0f + 2.0f*(i / 10) + 0.1f*seed);
+        Zeta::Circle circle(pos, 0.5f);
+        handler.createRigidBody(pos, 1, 0.5f, 1.0f, Zeta::RIGID_CIRCLE_COLLIDER, &circle)->vel.set(seed - 0.5f*i, 0);
+    }
+};
+
+bool worldBatchTests() {
+    bool failed = 0;
+
+    {
+        // stepping worlds on the batch's threads has to match stepping each world alone
+        const int worldCount = 6;
+
+        Zeta::WorldBatch batch(3);
+        Zeta::Handler* alone[worldCount];
+        float leftover[worldCount];
+
+        for (int i = 0; i < worldCount; ++i) {
+            Zeta::Handler* handler = new Zeta::Handler();
+            buildBatchWorld(*handler, i);
+            batch.addWorld(handler);
+
+            alone[i] = new Zeta::Handler();
+            buildBatchWorld(*alone[i], i);
+            leftover[i] = 0.0f;
+        }
+
+        int mismatches = 0;
+
+        for (int f = 0; f < 60; ++f) {
+            // uneven frame times so the leftover dt of each world matters
+            float dt = (f % 3 ? 1.0f/60.0f : 1.0f/40.0f);
+            batch.update(dt);
+
+            for (int i = 0; i < worldCount; ++i) {
+                leftover[i] += dt;
+                int steps = alone[i]->update(leftover[i]);
+
+                mismatches += steps != batch.getWorldSteps(i);
+                mismatches += alone[i]->getChecksum() != batch.getWorld(i)->getChecksum();
+            }
+        }
+
+        for (int i = 0; i < worldCount; ++i) { delete alone[i]; }
+
+        failed |= UNIT_TEST("Batch Matches Stepping Alone", mismatches, 0);
+    }
+
+    return failed;
+};